@@ -1,6 +1,8 @@
 #include <benchmark/benchmark.h>
 #include <pulse/pulse.hpp>
 #include <chrono>
+#include <cstdint>
+#include <vector>
 
 using namespace pulse;
 using namespace std::chrono_literals;
@@ -111,4 +113,29 @@ static void BM_throttle_latest(benchmark::State& state) {
 }
 BENCHMARK(BM_throttle_latest)->Arg(100)->Arg(1000)->Arg(10000);
 
+// Fan-in of N subjects, one value from each per iteration:
+// Arg(1) = 0 -> nested pairwise merge(a, merge(b, ...)), 1 -> flat merge_all
+static void BM_merge_fanin(benchmark::State& st) {
+  const auto n = static_cast<std::size_t>(st.range(0));
+  std::vector<subject<int>> subjects(n);
+  std::vector<observable<int>> srcs;
+  for (auto& s : subjects) srcs.push_back(s.as_observable());
+
+  observable<int> merged = srcs[0];
+  if (st.range(1) == 0) {
+    for (std::size_t i = 1; i < n; ++i) merged = merge<int>(merged, srcs[i]);
+  } else {
+    merged = merge_all(srcs);
+  }
+  std::int64_t sink = 0;
+  auto sub = merged.subscribe([&](int v){ sink += v; });
+
+  for (auto _ : st) {
+    for (auto& s : subjects) s.on_next(1);
+  }
+  benchmark::DoNotOptimize(sink);
+  st.SetItemsProcessed(st.iterations() * static_cast<std::int64_t>(n));
+}
+BENCHMARK(BM_merge_fanin)->ArgsProduct({{8, 64, 512}, {0, 1}});
+
 BENCHMARK_MAIN();
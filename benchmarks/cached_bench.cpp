@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+#include <pulse/pulse.hpp>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace pulse;
+
+// Search-as-you-type: prefixes of 50 popular queries, typed over and over.
+// The backend costs ~20us of CPU per query.
+// Arg(0): switch_map(backend), 1: switch_map(cached(backend))
+static void BM_prefix_search(benchmark::State& state) {
+  const bool use_cache = state.range(0) != 0;
+  std::vector<std::string> typed;
+  std::mt19937 rng{7};
+  for (int i = 0; i < 2000; ++i) {
+    const std::string q = "query-" + std::to_string(std::uniform_int_distribution<int>(0, 49)(rng));
+    for (std::size_t n = 2; n <= q.size(); ++n) typed.push_back(q.substr(0, n));
+  }
+
+  std::int64_t calls = 0;
+  auto backend = [&calls](const std::string& q){
+    ++calls;
+    const auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(20);
+    while (std::chrono::steady_clock::now() < until) {}
+    return from_range(std::vector<std::string>{"result for " + q});
+  };
+  auto memo = cached<std::string>(backend, 1024, std::chrono::seconds(60));
+
+  subject<std::string> input;
+  std::int64_t results = 0;
+  auto sub = use_cache
+    ? (input.as_observable() | switch_map(memo)).subscribe([&](const std::string&){ ++results; })
+    : (input.as_observable() | switch_map(backend)).subscribe([&](const std::string&){ ++results; });
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    input.on_next(typed[i]);
+    if (++i == typed.size()) i = 0;
+  }
+  benchmark::DoNotOptimize(results);
+  state.SetItemsProcessed(state.iterations());
+  state.counters["backend_calls/query"] = static_cast<double>(calls) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_prefix_search)->Arg(0)->Arg(1);
+
+// Raw cache lookups (hits), sharded vs a single shard
+static void BM_lru_cache_get(benchmark::State& state) {
+  static lru_cache<int, int>* cache = nullptr;
+  if (state.thread_index() == 0) {
+    cache = new lru_cache<int, int>(4096, std::chrono::steady_clock::duration::zero(),
+                                    static_cast<std::size_t>(state.range(0)));
+    for (int k = 0; k < 4096; ++k) cache->put(k, k);
+  }
+  int k = state.thread_index() * 997;
+  std::int64_t sink = 0;
+  for (auto _ : state) {
+    if (auto v = cache->get(k)) sink += *v;
+    k = (k + 1) & 4095;
+  }
+  benchmark::DoNotOptimize(sink);
+  state.SetItemsProcessed(state.iterations());
+  if (state.thread_index() == 0) {
+    delete cache;
+    cache = nullptr;
+  }
+}
+BENCHMARK(BM_lru_cache_get)->Arg(1)->Arg(16)->Threads(1)->Threads(4)->UseRealTime();
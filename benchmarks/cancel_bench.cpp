@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+#include <pulse/pulse.hpp>
+#include <atomic>
+#include <memory>
+#include <string>
+
+using namespace pulse;
+
+// Bursty typing into switch_map: every keystroke starts an inner "search" that
+// posts several work chunks to the pool and the next keystroke cancels it.
+// Arg(0): inner posts plain tasks guarded by an alive flag (popped and run dead),
+// Arg(1): inner posts with a cancel_group, reset() unlinks what is still queued.
+// Counter "wasted" = tasks that reached a worker after their search was cancelled.
+static void BM_switch_map_dead_tasks(benchmark::State& state) {
+  const bool grouped = state.range(0) != 0;
+  constexpr int keystrokes = 200;
+  constexpr int chunks = 16;
+
+  thread_pool pool{2};
+  std::atomic<std::int64_t> wasted{0};
+  std::atomic<std::int64_t> useful{0};
+
+  auto search = [&](int q) {
+    return observable<int>::create([&, q](auto on_next, auto, auto) {
+      if (grouped) {
+        auto g = std::make_shared<cancel_group>();
+        for (int c = 0; c < chunks; ++c) {
+          pool.post([&, g, on_next, q]{
+            if (g->cancelled()) { wasted.fetch_add(1, std::memory_order_relaxed); return; }
+            useful.fetch_add(1, std::memory_order_relaxed);
+            on_next(q);
+          }, g);
+        }
+        return make_subscription(g);
+      }
+      auto alive = std::make_shared<std::atomic<bool>>(true);
+      for (int c = 0; c < chunks; ++c) {
+        pool.post([&, alive, on_next, q]{
+          if (!*alive) { wasted.fetch_add(1, std::memory_order_relaxed); return; }
+          useful.fetch_add(1, std::memory_order_relaxed);
+          on_next(q);
+        });
+      }
+      return subscription([alive]{ *alive = false; });
+    });
+  };
+
+  for (auto _ : state) {
+    subject<int> typing;
+    std::atomic<int> results{0};
+    auto sub = (typing.as_observable() | switch_map(search))
+                 .subscribe([&](int){ results.fetch_add(1, std::memory_order_relaxed); });
+    for (int k = 0; k < keystrokes; ++k) typing.on_next(k);
+    sub.reset();
+
+    std::atomic<bool> flushed{false};
+    pool.post([&]{ flushed.store(true, std::memory_order_release); });
+    while (!flushed.load(std::memory_order_acquire)) std::this_thread::yield();
+    benchmark::DoNotOptimize(results.load());
+  }
+
+  state.counters["wasted"] = benchmark::Counter(static_cast<double>(wasted.load()),
+                                                benchmark::Counter::kAvgIterations);
+  state.counters["useful"] = benchmark::Counter(static_cast<double>(useful.load()),
+                                                benchmark::Counter::kAvgIterations);
+  state.counters["dropped"] = benchmark::Counter(static_cast<double>(pool.dropped_tasks()),
+                                                 benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_switch_map_dead_tasks)->Arg(0)->Arg(1)->UseRealTime();
@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+#include <pulse/pulse.hpp>
+#include <cstdint>
+#include <vector>
+
+using namespace pulse;
+
+// Risk-style graph: 100 inputs, a 19-node chain and a book per input, two
+// portfolio totals over the books (2k+ nodes). Every iteration moves one input.
+static void BM_cell_risk_2k(benchmark::State& state) {
+  constexpr int inputs = 100, chain = 19;
+  cell_graph g;
+  std::vector<cell<double>> in;
+  std::vector<computed<double>> nodes;
+  std::vector<computed<double>> books;
+  for (int i = 0; i < inputs; ++i) {
+    in.emplace_back(g, 1.0);
+    nodes.emplace_back([](double x){ return x * 1.01; }, in.back());
+    for (int k = 1; k < chain; ++k)
+      nodes.emplace_back([](double x){ return x + 0.5; }, nodes.back());
+    books.emplace_back([](double x, double y){ return x + y; }, nodes.back(), in.back());
+  }
+  computed<double> even([](double a, double b){ return a + b; }, books[0], books[2]);
+  computed<double> odd([](double a, double b){ return a + b; }, books[1], books[3]);
+  double sink = 0;
+  auto sub = even.as_observable().subscribe([&](double v){ sink += v; });
+
+  const std::size_t before = g.recomputations();
+  double px = 1.0;
+  int i = 0;
+  for (auto _ : state) {
+    px += 0.25;
+    in[i].set(px);
+    if (++i == inputs) i = 0;
+  }
+  benchmark::DoNotOptimize(sink);
+  state.SetItemsProcessed(state.iterations());
+  state.counters["recomputes/write"] =
+    static_cast<double>(g.recomputations() - before) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_cell_risk_2k);
+
+// Diamond a -> (b, c) -> d: cells recompute d once per write ...
+static void BM_cell_diamond(benchmark::State& state) {
+  cell_graph g;
+  cell<int> a{g, 0};
+  computed b([](int x){ return x + 1; }, a);
+  computed c([](int x){ return x * 2; }, a);
+  computed d([](int x, int y){ return x + y; }, b, c);
+  std::int64_t sink = 0, emissions = 0;
+  auto sub = d.as_observable().subscribe([&](int v){ sink += v; ++emissions; });
+  int i = 0;
+  for (auto _ : state) a.set(++i);
+  benchmark::DoNotOptimize(sink);
+  state.SetItemsProcessed(state.iterations());
+  state.counters["emissions/write"] = static_cast<double>(emissions - 1) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_cell_diamond);
+
+// ... nested combine_latest recomputes it per path (one glitch per write)
+static void BM_combine_latest_diamond(benchmark::State& state) {
+  subject<int> a;
+  auto src = a.as_observable();
+  auto b = src | map([](int x){ return x + 1; });
+  auto c = src | map([](int x){ return x * 2; });
+  std::int64_t sink = 0, emissions = 0;
+  auto sub = combine_latest(b, c, [](int x, int y){ return x + y; })
+               .subscribe([&](int v){ sink += v; ++emissions; });
+  int i = 0;
+  for (auto _ : state) a.on_next(++i);
+  benchmark::DoNotOptimize(sink);
+  state.SetItemsProcessed(state.iterations());
+  state.counters["emissions/write"] = static_cast<double>(emissions) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_combine_latest_diamond);
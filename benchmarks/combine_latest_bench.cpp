@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+#include <pulse/pulse.hpp>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace pulse;
+
+template <std::size_t... I>
+static auto combine_12(std::vector<subject<double>>& in, std::index_sequence<I...>) {
+  return [&in](auto... mode) {
+    // a little pricing math per input (discounting)
+    return combine_latest(mode..., [](auto... v){ return ((v * std::exp(-0.01 * v)) + ...); },
+                          in[I].as_observable()...);
+  };
+}
+
+// 12 inputs (a pricing node), every tick updates all of them.
+// Arg(0) = 0: recompute per update, 1: coalesce_on(strand), drained once per tick
+static void BM_combine_latest_12(benchmark::State& state) {
+  const bool coalesce = state.range(0) != 0;
+  std::vector<subject<double>> in(12);
+  strand turn;
+  auto make = combine_12(in, std::make_index_sequence<12>{});
+  double sink = 0;
+  std::int64_t emissions = 0;
+  auto on_next = [&](double v){ sink += v; ++emissions; };
+  auto sub = coalesce ? make(coalesce_on(turn)).subscribe(on_next) : make().subscribe(on_next);
+
+  double px = 1.0;
+  for (auto _ : state) {
+    px += 0.25;
+    for (auto& s : in) s.on_next(px);
+    if (coalesce) turn.drain();
+  }
+  benchmark::DoNotOptimize(sink);
+  state.SetItemsProcessed(state.iterations()); // ticks
+  state.counters["emissions/tick"] = static_cast<double>(emissions) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_combine_latest_12)->Arg(0)->Arg(1);
+
+// Two inputs, alternating updates
+static void BM_combine_latest_2(benchmark::State& state) {
+  subject<int> a, b;
+  std::int64_t sink = 0;
+  auto sub = combine_latest(a.as_observable(), b.as_observable(), [](int x, int y){ return x + y; })
+               .subscribe([&](int v){ sink += v; });
+  int i = 0;
+  for (auto _ : state) {
+    a.on_next(++i);
+    b.on_next(i);
+  }
+  benchmark::DoNotOptimize(sink);
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_combine_latest_2);
@@ -0,0 +1,43 @@
+#include <benchmark/benchmark.h>
+#include <pulse/pulse.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace pulse;
+using namespace std::chrono_literals;
+
+// 64 I/O-like inner observables (~200us each, answered from a pool task).
+// Arg(0) = 0: concat_map, otherwise concat_map_eager with prefetch = Arg(0)
+static void BM_concat_map_io(benchmark::State& state) {
+  const auto prefetch = static_cast<std::size_t>(state.range(0));
+  thread_pool pool{16};
+  std::vector<int> in(64);
+  for (int i = 0; i < 64; ++i) in[i] = i;
+
+  auto fetch = [&pool](int x) {
+    return observable<int>::create([&pool, x](auto on_next, auto, auto on_done){
+      pool.post([x, on_next, on_done]{
+        std::this_thread::sleep_for(200us);
+        on_next(x);
+        on_done();
+      });
+      return subscription{};
+    });
+  };
+
+  for (auto _ : state) {
+    std::atomic<bool> done{false};
+    std::int64_t sink = 0; // emission is serialized
+    auto on_done = [&]{ done.store(true, std::memory_order_release); };
+    auto sub = prefetch == 0
+      ? (from_range(in) | concat_map(fetch)).subscribe([&](int v){ sink += v; }, nullptr, on_done)
+      : (from_range(in) | concat_map_eager(fetch, prefetch)).subscribe([&](int v){ sink += v; }, nullptr, on_done);
+    while (!done.load(std::memory_order_acquire)) std::this_thread::yield();
+    benchmark::DoNotOptimize(sink);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(in.size()));
+}
+BENCHMARK(BM_concat_map_io)->Arg(0)->Arg(1)->Arg(4)->Arg(16)->UseRealTime()->Unit(benchmark::kMillisecond);
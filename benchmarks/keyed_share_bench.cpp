@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+#include <pulse/pulse.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace pulse;
+
+// A backend call costing ~20us of CPU, answered from the io strand
+static observable<std::string> backend(strand& io, std::string q, std::int64_t& calls) {
+  return observable<std::string>::create([&io, &calls, q = std::move(q)](auto on_next, auto, auto on_done){
+    ++calls;
+    auto group = std::make_shared<cancel_group>();
+    io.post([q, on_next, on_done]{
+      const auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(20);
+      while (std::chrono::steady_clock::now() < until) {}
+      if (on_next) on_next("[result] " + q);
+      if (on_done) on_done();
+    }, group);
+    return make_subscription(group);
+  });
+}
+
+// 40 users ask for the same popular key at once.
+// Arg(0): every request calls the backend, 1: coalesce_by_key
+static void BM_popular_key_burst(benchmark::State& state) {
+  const bool coalesce = state.range(0) != 0;
+  strand io;
+  std::int64_t calls = 0, answers = 0;
+  auto plain = [&](const std::string& q){ return backend(io, q, calls); };
+  auto shared = coalesce_by_key<std::string>([](const std::string& q){ return q; }, plain);
+
+  for (auto _ : state) {
+    std::vector<subscription> subs;
+    subs.reserve(40);
+    for (int i = 0; i < 40; ++i) {
+      auto o = coalesce ? shared(std::string("pulse")) : plain(std::string("pulse"));
+      subs.push_back(o.subscribe([&](const std::string&){ ++answers; }));
+    }
+    io.drain();
+  }
+  benchmark::DoNotOptimize(answers);
+  state.SetItemsProcessed(state.iterations() * 40);
+  state.counters["backend_calls/burst"] = static_cast<double>(calls) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_popular_key_burst)->Arg(0)->Arg(1);
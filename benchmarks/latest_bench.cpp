@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+#include <pulse/pulse.hpp>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace pulse;
+
+namespace {
+struct quote {
+  double bid;
+  double ask;
+  std::int64_t ts;
+};
+
+quote make_value(quote*, std::int64_t i) { return quote{double(i), double(i) + 0.5, i}; }
+std::string make_value(std::string*, std::int64_t i) { return "px:" + std::to_string(i); }
+} // namespace
+
+// topic{keep_latest}::publish while Arg(0) threads poll latest() in a loop.
+// items_per_second = publishes, "reads" = latest() calls per second across readers.
+template <class T>
+static void BM_topic_latest(benchmark::State& state) {
+  const int nreaders = static_cast<int>(state.range(0));
+  inline_executor ex;
+  topic<T> t{keep_latest};
+  auto sub = t.subscribe(ex, priority{0}, bp_none{}, [](const T&){});
+  t.publish(make_value(static_cast<T*>(nullptr), 0));
+
+  std::atomic<bool> stop{false};
+  std::atomic<std::int64_t> reads{0};
+  std::vector<std::thread> readers;
+  for (int r = 0; r < nreaders; ++r) {
+    readers.emplace_back([&]{
+      std::int64_t local = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        benchmark::DoNotOptimize(t.latest());
+        ++local;
+      }
+      reads.fetch_add(local);
+    });
+  }
+
+  std::int64_t i = 0;
+  for (auto _ : state) {
+    t.publish(make_value(static_cast<T*>(nullptr), ++i));
+  }
+  stop = true;
+  for (auto& th : readers) th.join();
+  state.SetItemsProcessed(state.iterations());
+  state.counters["reads"] = benchmark::Counter(static_cast<double>(reads.load()), benchmark::Counter::kIsRate);
+}
+BENCHMARK_TEMPLATE(BM_topic_latest, quote)->Arg(0)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_topic_latest, std::string)->Arg(0)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
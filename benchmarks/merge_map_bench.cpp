@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+#include <pulse/pulse.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace pulse;
+using namespace std::chrono_literals;
+
+// merge_map(f, K) over 256 outer values; every inner observable simulates a
+// ~100us call to a local service by answering from a thread_pool task.
+static void BM_merge_map_async(benchmark::State& state) {
+  const auto k = static_cast<std::size_t>(state.range(0));
+  thread_pool pool{64};
+  std::vector<int> in(256);
+  for (int i = 0; i < 256; ++i) in[i] = i;
+
+  auto lookup = [&pool](int x) {
+    return observable<int>::create([&pool, x](auto on_next, auto, auto on_done){
+      pool.post([x, on_next, on_done]{
+        std::this_thread::sleep_for(100us);
+        on_next(x);
+        on_done();
+      });
+      return subscription{};
+    });
+  };
+
+  for (auto _ : state) {
+    std::atomic<bool> done{false};
+    std::atomic<int> sink{0};
+    auto sub = (from_range(in) | merge_map(lookup, k))
+                 .subscribe([&](int v){ sink.fetch_add(v, std::memory_order_relaxed); },
+                            nullptr,
+                            [&]{ done.store(true, std::memory_order_release); });
+    while (!done.load(std::memory_order_acquire)) std::this_thread::yield();
+    benchmark::DoNotOptimize(sink.load());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(in.size()));
+}
+BENCHMARK(BM_merge_map_async)->RangeMultiplier(2)->Range(1, 64)->UseRealTime()->Unit(benchmark::kMillisecond);
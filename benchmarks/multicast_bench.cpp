@@ -0,0 +1,136 @@
+#include <benchmark/benchmark.h>
+#include <pulse/pulse.hpp>
+#include <pulse/core/ring_topic.hpp>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace pulse;
+
+// subject::on_next fan-out to N subscribers (lock-free snapshot, no per-event copy)
+static void BM_subject_fanout(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  subject<int> s;
+  std::int64_t sink = 0;
+  std::vector<subscription> subs;
+  subs.reserve(n);
+  for (std::size_t i = 0; i < n; ++i)
+    subs.push_back(s.as_observable().subscribe([&](int v){ sink += v; }));
+
+  int v = 0;
+  for (auto _ : state) {
+    s.on_next(++v);
+  }
+  benchmark::DoNotOptimize(sink);
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+BENCHMARK(BM_subject_fanout)->RangeMultiplier(10)->Range(1, 10000);
+
+// share() fan-out to N subscribers
+static void BM_share_fanout(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  subject<int> s;
+  auto shared = share(s.as_observable());
+  std::int64_t sink = 0;
+  std::vector<subscription> subs;
+  subs.reserve(n);
+  for (std::size_t i = 0; i < n; ++i)
+    subs.push_back(shared.subscribe([&](int v){ sink += v; }));
+
+  int v = 0;
+  for (auto _ : state) {
+    s.on_next(++v);
+  }
+  benchmark::DoNotOptimize(sink);
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+BENCHMARK(BM_share_fanout)->RangeMultiplier(10)->Range(1, 10000);
+
+// Subscribe + unsubscribe on a share() with N long-lived subscribers
+static void BM_share_churn(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  subject<int> s;
+  auto shared = share(s.as_observable());
+  std::vector<subscription> subs;
+  for (std::size_t i = 0; i < n; ++i) subs.push_back(shared.subscribe([](int){}));
+
+  for (auto _ : state) {
+    auto tmp = shared.subscribe([](int){});
+    tmp.reset();
+  }
+}
+BENCHMARK(BM_share_churn)->RangeMultiplier(10)->Range(1, 10000);
+
+// topic vs ring_topic fan-out to N inline subscribers
+static void BM_topic_fanout(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  inline_executor ex;
+  topic<int> t;
+  std::int64_t sink = 0;
+  std::vector<subscription> subs;
+  for (std::size_t i = 0; i < n; ++i)
+    subs.push_back(t.subscribe(ex, priority{0}, bp_none{}, [&](int v){ sink += v; }));
+
+  int v = 0;
+  for (auto _ : state) {
+    t.publish(++v);
+  }
+  benchmark::DoNotOptimize(sink);
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+BENCHMARK(BM_topic_fanout)->RangeMultiplier(10)->Range(1, 1000);
+
+static void BM_ring_topic_fanout(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  inline_executor ex;
+  ring_topic<int> t(1024);
+  std::int64_t sink = 0;
+  std::vector<subscription> subs;
+  for (std::size_t i = 0; i < n; ++i)
+    subs.push_back(t.subscribe(ex, priority{0}, bp_none{}, [&](int v){ sink += v; }));
+
+  int v = 0;
+  for (auto _ : state) {
+    t.publish(++v);
+  }
+  benchmark::DoNotOptimize(sink);
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n));
+}
+BENCHMARK(BM_ring_topic_fanout)->RangeMultiplier(10)->Range(1, 1000);
+
+// One producer, one subscriber on a pool thread: topic posts a task per event,
+// ring_topic reads runs of slots in place
+static void BM_topic_spsc(benchmark::State& state) {
+  thread_pool pool{1};
+  topic<std::int64_t> t;
+  std::atomic<std::int64_t> seen{0};
+  auto sub = t.subscribe(pool, priority{0}, bp_none{}, [&](std::int64_t){
+    seen.fetch_add(1, std::memory_order_relaxed);
+  });
+
+  std::int64_t sent = 0;
+  for (auto _ : state) {
+    t.publish(++sent);
+  }
+  while (seen.load(std::memory_order_relaxed) < sent) std::this_thread::yield();
+  state.SetItemsProcessed(sent);
+}
+BENCHMARK(BM_topic_spsc)->UseRealTime();
+
+static void BM_ring_topic_spsc(benchmark::State& state) {
+  thread_pool pool{1};
+  ring_topic<std::int64_t> t(4096);
+  std::atomic<std::int64_t> seen{0};
+  auto sub = t.subscribe(pool, priority{0}, bp_none{}, [&](std::int64_t){
+    seen.fetch_add(1, std::memory_order_relaxed);
+  });
+
+  std::int64_t sent = 0;
+  for (auto _ : state) {
+    t.publish(++sent);
+  }
+  while (seen.load(std::memory_order_relaxed) < sent) std::this_thread::yield();
+  state.SetItemsProcessed(sent);
+}
+BENCHMARK(BM_ring_topic_spsc)->UseRealTime();
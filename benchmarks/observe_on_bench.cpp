@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+#include <pulse/pulse.hpp>
+#include <atomic>
+#include <thread>
+
+using namespace pulse;
+
+// Two stages on the same pool: the topic delivers on pool workers, then
+// observe_on(pool) hops "again" to the same pool.
+// Arg(0): plain observe_on (post per event), Arg(1): observe_on(pool, inline_if_current).
+static void BM_same_pool_hop(benchmark::State& state) {
+  const bool inline_current = state.range(0) != 0;
+  thread_pool pool{1};
+  topic<int> t;
+
+  auto stage1 = as_observable(t, pool) | map([](int x){ return x + 1; });
+  auto stage2 = inline_current ? (stage1 | observe_on(pool, inline_if_current))
+                               : (stage1 | observe_on(pool));
+
+  std::atomic<std::int64_t> got{0};
+  auto sub = stage2.subscribe([&](int){ got.fetch_add(1, std::memory_order_relaxed); });
+
+  constexpr int n = 1000;
+  std::int64_t expected = 0;
+  for (auto _ : state) {
+    for (int i = 0; i < n; ++i) t.publish(i);
+    expected += n;
+    while (got.load(std::memory_order_acquire) < expected) std::this_thread::yield();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_same_pool_hop)->Arg(0)->Arg(1)->UseRealTime();
+
+// subject -> observe_on(pool): bursts of n events from one producer.
+// Arg(0): one task per event, Arg(1): observe_on(pool, batched{}) - one drain task per burst.
+static void BM_observe_on_burst(benchmark::State& state) {
+  const bool batch = state.range(0) != 0;
+  thread_pool pool{2};
+  subject<int> s;
+
+  auto src = s.as_observable();
+  auto out = batch ? (src | observe_on(pool, batched{})) : (src | observe_on(pool));
+
+  std::atomic<std::int64_t> got{0};
+  auto sub = out.subscribe([&](int){ got.fetch_add(1, std::memory_order_relaxed); });
+
+  constexpr int n = 1000;
+  std::int64_t expected = 0;
+  for (auto _ : state) {
+    for (int i = 0; i < n; ++i) s.on_next(i);
+    expected += n;
+    while (got.load(std::memory_order_acquire) < expected) std::this_thread::yield();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_observe_on_burst)->Arg(0)->Arg(1)->UseRealTime();
@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+#include <pulse/pulse.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace pulse;
+
+// ~10us of CPU work (stand-in for parsing / decompressing one message)
+static std::uint64_t heavy(int x) {
+  const auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(10);
+  std::uint64_t h = static_cast<std::uint64_t>(x);
+  while (std::chrono::steady_clock::now() < until) h = h * 6364136223846793005ULL + 1442695040888963407ULL;
+  return h;
+}
+
+static std::vector<int> inputs() {
+  std::vector<int> in(2000);
+  for (int i = 0; i < 2000; ++i) in[i] = i;
+  return in;
+}
+
+// Baseline: the same transform in a serial map
+static void BM_map_heavy_serial(benchmark::State& state) {
+  const auto in = inputs();
+  for (auto _ : state) {
+    std::uint64_t sink = 0;
+    auto sub = (from_range(in) | map(heavy)).subscribe([&](std::uint64_t v){ sink ^= v; });
+    benchmark::DoNotOptimize(sink);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(in.size()));
+}
+BENCHMARK(BM_map_heavy_serial)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// parallel_map on a pool of Arg(0) threads; Arg(1) = ordered
+static void BM_parallel_map_heavy(benchmark::State& state) {
+  thread_pool pool{static_cast<std::size_t>(state.range(0))};
+  const bool ordered = state.range(1) != 0;
+  const auto in = inputs();
+  for (auto _ : state) {
+    std::atomic<bool> done{false};
+    std::uint64_t sink = 0; // emission is serialized
+    auto sub = (from_range(in) | parallel_map(pool, heavy, {.ordered = ordered, .max_in_flight = 256}))
+                 .subscribe([&](std::uint64_t v){ sink ^= v; }, nullptr,
+                            [&]{ done.store(true, std::memory_order_release); });
+    while (!done.load(std::memory_order_acquire)) std::this_thread::yield();
+    benchmark::DoNotOptimize(sink);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(in.size()));
+}
+BENCHMARK(BM_parallel_map_heavy)
+  ->ArgsProduct({{1, 2, 4, 8}, {1, 0}})
+  ->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+#include <pulse/pulse.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace pulse;
+using namespace std::chrono_literals;
+
+// Backend call: 200us, but 5% of the calls take 20ms (the tail hedging cuts)
+static observable<int> backend_call(std::mt19937& rng, std::mutex& rng_m) {
+  bool slow;
+  {
+    std::lock_guard<std::mutex> lock(rng_m);
+    slow = std::uniform_int_distribution<int>(0, 99)(rng) < 5;
+  }
+  return observable<int>::create([slow](auto on_next, auto, auto on_done){
+    auto group = std::make_shared<cancel_group>();
+    std::thread([group, slow, on_next, on_done]{
+      std::this_thread::sleep_for(slow ? 20ms : 200us);
+      if (group->cancelled()) return;
+      if (on_next) on_next(1);
+      if (on_done) on_done();
+    }).detach();
+    return make_subscription(group);
+  });
+}
+
+// Arg(0): one attempt per call, Arg(1): hedge after 1ms, up to 3 attempts
+static void BM_hedge_tail(benchmark::State& state) {
+  const std::size_t attempts = state.range(0) ? 3 : 1;
+  std::mt19937 rng{42};
+  std::mutex rng_m;
+  auto stats = std::make_shared<hedge_counters>();
+  std::vector<double> lat_us;
+
+  for (auto _ : state) {
+    std::atomic<bool> done{false};
+    const auto t0 = std::chrono::steady_clock::now();
+    auto sub = hedge([&]{ return backend_call(rng, rng_m); }, 1ms, attempts, stats)
+                 .subscribe([](int){}, nullptr, [&]{ done.store(true, std::memory_order_release); });
+    while (!done.load(std::memory_order_acquire)) std::this_thread::yield();
+    lat_us.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count());
+  }
+
+  std::sort(lat_us.begin(), lat_us.end());
+  const auto s = stats->snapshot();
+  state.counters["p50_us"] = lat_us[lat_us.size() / 2];
+  state.counters["p99_us"] = lat_us[lat_us.size() * 99 / 100];
+  state.counters["hedged%"] = 100.0 * static_cast<double>(s.hedged) / static_cast<double>(s.calls);
+  state.counters["hedge_wins%"] = 100.0 * static_cast<double>(s.hedge_wins) / static_cast<double>(s.calls);
+}
+BENCHMARK(BM_hedge_tail)->Arg(0)->Arg(1)->Iterations(400)->UseRealTime();
+
+// Cost of race() itself: three synchronous sources, the first one wins
+static void BM_race_sync(benchmark::State& state) {
+  auto a = observable<int>::create([](auto on_next, auto, auto on_done){
+    on_next(1);
+    on_done();
+    return subscription{};
+  });
+  auto never = observable<int>::create([](auto, auto, auto){ return subscription{}; });
+  auto r = race(a, never, never);
+  std::int64_t sink = 0;
+  for (auto _ : state) {
+    auto sub = r.subscribe([&](int v){ sink += v; });
+  }
+  benchmark::DoNotOptimize(sink);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_race_sync);
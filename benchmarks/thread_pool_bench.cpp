@@ -0,0 +1,47 @@
+#include <benchmark/benchmark.h>
+#include <pulse/pulse.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace pulse;
+
+// Fan-out: P producer threads post small tasks into the pool, wait until all ran.
+// Arg(0) = unpinned (default pool), Arg(1) = NUMA-aware, workers pinned to their node,
+// Arg(2) = NUMA-aware, every worker pinned to a single CPU.
+static void BM_pool_fanout(benchmark::State& state) {
+  const auto mode = state.range(0);
+
+  thread_pool_options opts;
+  opts.threads = std::max(2u, std::thread::hardware_concurrency());
+  opts.numa_aware = mode >= 1;
+  opts.pin_per_cpu = mode == 2;
+  thread_pool pool{opts};
+
+  constexpr int producers = 4;
+  constexpr int per_producer = 2000;
+  std::atomic<int> done{0};
+  std::atomic<std::uint64_t> sink{0};
+
+  for (auto _ : state) {
+    done.store(0, std::memory_order_relaxed);
+    std::vector<std::thread> ps;
+    for (int p = 0; p < producers; ++p) {
+      ps.emplace_back([&]{
+        for (int i = 0; i < per_producer; ++i) {
+          pool.post([&, i]{
+            sink.fetch_add(static_cast<std::uint64_t>(i), std::memory_order_relaxed);
+            done.fetch_add(1, std::memory_order_release);
+          });
+        }
+      });
+    }
+    for (auto& t : ps) t.join();
+    while (done.load(std::memory_order_acquire) < producers * per_producer)
+      std::this_thread::yield();
+  }
+  state.SetItemsProcessed(state.iterations() * producers * per_producer);
+}
+BENCHMARK(BM_pool_fanout)->Arg(0)->Arg(1)->Arg(2)->UseRealTime();
@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+#include <pulse/pulse.hpp>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace pulse;
+
+static std::vector<int> values(int n) {
+  std::vector<int> v(n);
+  for (int i = 0; i < n; ++i) v[i] = i;
+  return v;
+}
+
+template <std::size_t... I>
+static auto zip_n(const observable<int>& s, std::index_sequence<I...>) {
+  return zip([](auto... v){ return (v + ...); }, ((void)I, s)...);
+}
+
+// N-way zip of synchronous demand-aware sources (Arg = number of values)
+template <std::size_t N>
+static void BM_zip_nway(benchmark::State& state) {
+  auto src = from_range(values(static_cast<int>(state.range(0))));
+  auto z = zip_n(src, std::make_index_sequence<N>{});
+  for (auto _ : state) {
+    std::int64_t sink = 0;
+    auto sub = z.subscribe([&](int v){ sink += v; });
+    benchmark::DoNotOptimize(sink);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_zip_nway, 2)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_zip_nway, 4)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_zip_nway, 8)->Arg(10000);
+
+// 2-way zip, each source a subject fed from its own thread.
+// Arg(0) = block (metered through the subjects' gates), Arg(1) = error (free-running)
+static void BM_zip_threads(benchmark::State& state) {
+  constexpr int n = 10000;
+  const zip_options opts{.capacity = 16384,
+                         .overflow = state.range(0) ? zip_overflow::error : zip_overflow::block,
+                         .single_producer = true};
+  for (auto _ : state) {
+    subject<int> a, b;
+    std::int64_t sink = 0;
+    auto sub = zip(opts, [](int x, int y){ return x + y; }, a.as_observable(), b.as_observable())
+                 .subscribe([&](int v){ sink += v; });
+    std::thread ta([&]{ for (int i = 0; i < n; ++i) a.on_next(i); });
+    std::thread tb([&]{ for (int i = 0; i < n; ++i) b.on_next(i); });
+    ta.join();
+    tb.join();
+    benchmark::DoNotOptimize(sink);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_zip_threads)->Arg(0)->Arg(1)->UseRealTime();
@@ -34,19 +34,24 @@ private:
     auto async_search = [&](std::string query){
       return observable<std::string>::create(
         [q = std::move(query), &io](auto on_next, auto /*on_err*/, auto /*on_done*/){
+          // switch_map resets the previous search: its queued work is dropped from the pool
+          auto group = std::make_shared<cancel_group>();
           io.post([q, on_next]{
             std::this_thread::sleep_for(250ms); // network simulation
             if (on_next) on_next(std::string("[result] ") + q);
-          });
-          return subscription{};
+          }, group);
+          return make_subscription(group);
         }
       );
     };
 
+    // identical queries in flight at the same time share one backend call
+    auto search = coalesce_by_key<std::string>([](const std::string& q){ return q; }, async_search);
+
     return input
       | filter([](const std::string& s){ return s.size() >= 2; })
       | debounce(200ms, ui)
-      | switch_map(async_search)
+      | switch_map(search)
       | observe_on(ui);
   }
 
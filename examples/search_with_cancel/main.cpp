@@ -23,15 +23,20 @@ int main() {
 
   // Dummy async "search": there could be a real IO operation here
   auto fake_search = [&](std::string s){
-    return observable<std::string>::create([s = std::move(s)](auto on_next, auto, auto){
+    return observable<std::string>::create([s = std::move(s)](auto on_next, auto, auto on_done){
       on_next("result for: " + s);
+      if (on_done) on_done();
       return subscription{};
     });
   };
 
+  // Completed searches are remembered for 30s: a repeated query is answered
+  // from the cache without calling the backend
+  auto search = cached<std::string>(fake_search, 256, std::chrono::seconds(30));
+
   // We take only the last request (canceling the previous ones)
   auto results = qstream
-    | switch_map(fake_search)
+    | switch_map(search)
     | observe_on(ui);
 
   std::latch done{1};
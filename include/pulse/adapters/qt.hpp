@@ -29,6 +29,8 @@ namespace qt {
 // ====================================================================================
 class qt_executor : public executor {
 public:
+  using executor::post;
+
   explicit qt_executor(QObject* target = QCoreApplication::instance())
   : target_(target ? target : QCoreApplication::instance()) {}
 
@@ -47,6 +49,12 @@ public:
 #endif
   }
 
+  // Delivery is inline-safe when we already are on the target's thread
+  bool running_in_this_thread() const noexcept override {
+    QObject* tgt = target_;
+    return tgt && tgt->thread() == QThread::currentThread();
+  }
+
   QObject* target() const { return target_; }
 
 private:
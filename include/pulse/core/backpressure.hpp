@@ -1,30 +1,55 @@
 #pragma once
+#include <pulse/core/bp_stats.hpp>
+#include <pulse/core/cancel_group.hpp>
+#include <algorithm>
 #include <atomic>
 #include <array>
 #include <cstddef>
 #include <mutex>
 #include <optional>
+#include <type_traits>
 #include <deque>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <thread>
 #include <chrono>
+#include <condition_variable>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace pulse {
 
+// Every built-in policy keeps bp_stats counters (see bp_stats.hpp), readable with
+// stats() from any thread. Copying a policy copies its configuration only.
+
 // ── BASIC POLICIES ───────────────────────────────────────────────────────────────
 
 struct bp_none {
-  bool accept() noexcept { return true; }
+  bool accept() noexcept { stats_.accepted(); return true; }
+  bp_stats stats() const noexcept { return stats_.snapshot(); }
+
+private:
+  [[no_unique_address]] detail::bp_counters stats_;
 };
 
 struct bp_drop {
   std::size_t remaining;
   explicit bp_drop(std::size_t n) : remaining(n) {}
   bool accept() noexcept {
-    if (remaining == 0)
+    if (remaining == 0) {
+      stats_.dropped();
       return false;
+    }
     --remaining;
+    stats_.accepted();
     return true;
   }
+  bp_stats stats() const noexcept { return stats_.snapshot(); }
+
+private:
+  [[no_unique_address]] detail::bp_counters stats_;
 };
 
 // ── "Take only the last" ─────────────────────────────────────────────────────────
@@ -36,7 +61,10 @@ public:
   void publish(const T &v, Executor &ex, Invoke invoke) {
     {
       std::lock_guard<std::mutex> lock(m_);
+      if (last_) stats_.coalesced();
       last_ = v;
+      stats_.accepted();
+      stats_.depth(1);
     }
     bool expected = false;
     if (scheduled_.compare_exchange_strong(expected, true,
@@ -47,6 +75,7 @@ public:
           {
             std::lock_guard<std::mutex> lock(m_);
             cur.swap(last_);
+            stats_.depth(0);
           }
           if (!cur)
             break;
@@ -57,10 +86,86 @@ public:
     }
   }
 
+  bp_stats stats() const noexcept { return stats_.snapshot(); }
+
 private:
   std::mutex m_;
   std::optional<T> last_;
   std::atomic<bool> scheduled_{false};
+  [[no_unique_address]] detail::bp_counters stats_;
+};
+
+// ── "Latest per key" ─────────────────────────────────────────────────────────────
+// Keyed conflation: during a burst every key is delivered once, with its freshest
+// value, in the order the keys became dirty. One drain task per burst.
+// Memory is bounded by the number of distinct keys, not by the burst size.
+// KeyFn: const T& -> hashable key; must be copyable (topic keeps a copy of the
+// policy). Pass it to the constructor, or name a default-constructible type.
+template <class T, class KeyFn>
+class bp_latest_by_key {
+  using key_type = std::decay_t<std::invoke_result_t<KeyFn&, const T&>>;
+
+public:
+  bp_latest_by_key() = default;
+  explicit bp_latest_by_key(KeyFn key) : key_(std::move(key)) {}
+  bp_latest_by_key(const bp_latest_by_key& o) : key_(o.key_) {}
+
+  template <class Executor, class Invoke>
+  void publish(const T& v, Executor& ex, Invoke invoke) {
+    bool should_schedule = false;
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      auto [it, inserted] = slots_.try_emplace(key_(v));
+      slot& s = it->second;
+      s.value = v; // overwrite: only the freshest value per key is kept
+      stats_.accepted();
+      if (!s.dirty) {
+        s.dirty = true;
+        dirty_.push_back(&s); // node-based map: the pointer is stable
+        stats_.depth(dirty_.size());
+      } else {
+        stats_.coalesced();
+      }
+      if (!scheduled_) { scheduled_ = true; should_schedule = true; }
+    }
+
+    if (should_schedule) {
+      ex.post([this, inv = std::move(invoke)]() mutable {
+        std::vector<T> batch;
+        for (;;) {
+          {
+            std::lock_guard<std::mutex> lock(m_);
+            if (dirty_.empty()) { scheduled_ = false; break; }
+            batch.reserve(dirty_.size());
+            for (slot* s : dirty_) {
+              batch.push_back(std::move(*s->value));
+              s->value.reset();
+              s->dirty = false;
+            }
+            dirty_.clear();
+            stats_.depth(0);
+          }
+          for (auto& x : batch) inv(x);
+          batch.clear();
+        }
+      });
+    }
+  }
+
+  bp_stats stats() const noexcept { return stats_.snapshot(); }
+
+private:
+  struct slot {
+    std::optional<T> value;
+    bool dirty{false};
+  };
+
+  KeyFn key_{};
+  std::mutex m_;
+  std::unordered_map<key_type, slot> slots_;
+  std::vector<slot*> dirty_; // insertion order of the keys of the current burst
+  bool scheduled_{false};
+  [[no_unique_address]] detail::bp_counters stats_;
 };
 
 // ── "Buffer for N events" ────────────────────────────────────────────────────────
@@ -71,6 +176,7 @@ class bp_buffer {
 public:
   explicit bp_buffer(std::size_t capacity = 64)
   : cap_(capacity ? capacity : 1) {}
+  bp_buffer(const bp_buffer& o) : cap_(o.cap_) {}
 
   template <class Executor, class Invoke>
   void publish(const T& v, Executor& ex, Invoke invoke) {
@@ -79,12 +185,13 @@ public:
       std::lock_guard<std::mutex> lock(m_);
       if (q_.size() < cap_) {
         q_.push_back(v);
+        stats_.accepted();
+        stats_.depth(q_.size());
         // if there was no active worker, you need to schedule one
         if (!scheduled_) { scheduled_ = true; should_schedule = true; }
       } else {
-        //TODO:
         // Buffer full - drop (can be changed to front/back eviction)
-        // You can set a drop counter here for tracing
+        stats_.dropped();
       }
     }
 
@@ -97,6 +204,7 @@ public:
             if (q_.empty()) { scheduled_ = false; break; }
             item.emplace(std::move(q_.front()));
             q_.pop_front();
+            stats_.depth(q_.size());
           }
           inv(*item);
         }
@@ -104,11 +212,440 @@ public:
     }
   }
 
+  bp_stats stats() const noexcept { return stats_.snapshot(); }
+
 private:
   std::mutex m_;
   std::deque<T> q_;
   std::size_t cap_;
   bool scheduled_{false};
+  [[no_unique_address]] detail::bp_counters stats_;
+};
+
+// ── "Rate limit" (token bucket) ──────────────────────────────────────────────────
+// Sustained `per_second` events with bursts of up to `burst`. The bucket is one
+// atomic (GCRA: the theoretical arrival time of the next event), so admission is
+// lock-free. Excess events are either dropped or deferred into a bounded FIFO
+// that one timer thread per policy drains as tokens refill; while anything is
+// deferred or on its way to the executor, new events queue behind it so the
+// order is kept. On a topic the policy posts through the subscriber's
+// cancel_group: after unsubscribe the deferred events are discarded (the timer
+// re-checks at least every 20ms). The timer is joined when the policy is
+// destroyed, so it never posts past the subscription that owns it.
+enum class rate_excess { drop, defer };
+
+template <class T>
+class bp_rate {
+public:
+  using clock = std::chrono::steady_clock;
+
+  explicit bp_rate(double per_second, std::size_t burst = 1,
+                   rate_excess excess = rate_excess::drop, std::size_t capacity = 1024)
+    : st_(std::make_shared<state>(per_second, burst, excess, capacity)) {}
+  bp_rate(const bp_rate& o)
+    : st_(std::make_shared<state>(o.st_->per_second, o.st_->burst, o.st_->excess, o.st_->cap)) {}
+  bp_rate& operator=(const bp_rate&) = delete;
+
+  ~bp_rate() {
+    {
+      std::lock_guard<std::mutex> lock(st_->m);
+      st_->stop = true;
+    }
+    st_->cv.notify_all();
+    if (!st_->timer.joinable()) return;
+    // A delivery running on the timer thread (inline executor) may drop the
+    // last reference to the policy: the thread still holds the state
+    if (st_->timer.get_id() == std::this_thread::get_id()) st_->timer.detach();
+    else st_->timer.join();
+  }
+
+  template <class Executor, class Invoke>
+  void publish(const T& v, Executor& ex, Invoke invoke) {
+    publish(v, ex, std::move(invoke), nullptr);
+  }
+
+  // group: cancelled when the subscriber goes away (topic passes its own)
+  template <class Executor, class Invoke>
+  void publish(const T& v, Executor& ex, Invoke invoke, std::shared_ptr<cancel_group> group) {
+    state& st = *st_;
+    if (st.excess == rate_excess::drop) {
+      if (!st.try_acquire(clock::now())) { st.stats.dropped(); return; }
+      st.stats.accepted();
+      ex.post([inv = std::move(invoke), v] { inv(v); }, std::move(group));
+      return;
+    }
+
+    bool deliver_now = false;
+    bool arm = false;
+    {
+      std::lock_guard<std::mutex> lock(st.m);
+      if (!st.armed && st.try_acquire(clock::now())) {
+        deliver_now = true;
+        st.stats.accepted();
+      } else if (st.q.size() < st.cap) {
+        st.q.push_back(v);
+        st.stats.accepted();
+        st.stats.depth(st.q.size());
+        if (!st.armed) {
+          st.armed = arm = true;
+          st.group = group;
+          st.sink = [&ex, inv = invoke, group](std::shared_ptr<std::vector<T>> batch) {
+            ex.post([inv, batch] { for (auto& x : *batch) inv(x); }, group);
+          };
+          if (!st.timer.joinable()) st.timer = std::thread([sp = st_] { sp->run_timer(); });
+        }
+      } else {
+        st.stats.dropped();
+      }
+    }
+    if (deliver_now) ex.post([inv = std::move(invoke), v] { inv(v); }, std::move(group));
+    if (arm) st.cv.notify_all();
+  }
+
+  bp_stats stats() const noexcept { return st_->stats.snapshot(); }
+
+private:
+  // Shared with the timer thread
+  struct state {
+    state(double rate, std::size_t b, rate_excess e, std::size_t c)
+      : per_second(rate > 0 ? rate : 1), burst(b ? b : 1), excess(e), cap(c ? c : 1),
+        interval(std::max<clock::rep>(1, static_cast<clock::rep>(
+          std::chrono::duration<double>(1.0 / per_second) / clock::duration(1)))),
+        tolerance(interval * static_cast<clock::rep>(burst)) {}
+
+    // GCRA: admit if the bucket would not overflow, lock-free
+    bool try_acquire(clock::time_point now) noexcept {
+      const clock::rep t = now.time_since_epoch().count();
+      clock::rep tat = tat_.load(std::memory_order_relaxed);
+      for (;;) {
+        const clock::rep next = std::max(tat, t) + interval;
+        if (next - t > tolerance) return false;
+        if (tat_.compare_exchange_weak(tat, next, std::memory_order_acq_rel,
+                                       std::memory_order_relaxed))
+          return true;
+      }
+    }
+
+    // Time until the next token is available
+    clock::duration wait(clock::time_point now) const noexcept {
+      const clock::rep t = now.time_since_epoch().count();
+      const clock::rep next = std::max(tat_.load(std::memory_order_relaxed), t) + interval;
+      return clock::duration(next - t > tolerance ? next - t - tolerance : 0);
+    }
+
+    // Timer: sleeps until the next token, moves what the bucket admits to the
+    // executor in one task and stays armed until that post is done, then
+    // idles until the queue is armed again or the policy goes away
+    void run_timer() {
+      std::unique_lock<std::mutex> lock(m);
+      for (;;) {
+        cv.wait(lock, [&] { return stop || armed; });
+        if (stop) return;
+        if (group && group->cancelled()) {
+          q.clear();
+          armed = false;
+          stats.depth(0);
+          continue;
+        }
+        const auto d = wait(clock::now());
+        if (d > clock::duration::zero()) {
+          cv.wait_for(lock, std::min<clock::duration>(d, std::chrono::milliseconds(20)));
+          continue;
+        }
+        auto batch = std::make_shared<std::vector<T>>();
+        const auto now = clock::now();
+        while (!q.empty() && try_acquire(now)) {
+          batch->push_back(std::move(q.front()));
+          q.pop_front();
+        }
+        stats.depth(q.size());
+        if (!batch->empty()) {
+          auto post = sink;
+          lock.unlock();
+          post(std::move(batch));
+          lock.lock();
+        }
+        if (q.empty()) armed = false;
+      }
+    }
+
+    const double per_second;
+    const std::size_t burst;
+    const rate_excess excess;
+    const std::size_t cap;
+    const clock::rep interval;   // clock ticks per token
+    const clock::rep tolerance;  // burst * interval
+    std::atomic<clock::rep> tat_{0};
+
+    std::mutex m;                // everything below
+    std::deque<T> q;
+    bool armed{false};           // deferred events queued or being posted
+    bool stop{false};
+    std::shared_ptr<cancel_group> group;
+    std::function<void(std::shared_ptr<std::vector<T>>)> sink; // posts a batch
+    std::condition_variable cv;
+    std::thread timer;
+    [[no_unique_address]] detail::bp_counters stats;
+  };
+
+  std::shared_ptr<state> st_;
+};
+
+// ── "Buffer with time-to-live" ─────────────────────────────────────────────────
+// Like bp_buffer, but every event is stamped with its enqueue time and the drain
+// task skips events that waited longer than `ttl` (counted as expired), which
+// bounds the age of what the consumer acts on. With ttl_stale::newest, the
+// newest expired event is still delivered when nothing fresher follows it, so
+// the consumer never ends a burst on an older state than necessary.
+// Clock: any monotonic clock; steady_clock is a vDSO call on Linux.
+enum class ttl_stale { drop, newest };
+
+template <class T, class Clock = std::chrono::steady_clock>
+class bp_ttl {
+public:
+  using clock = Clock;
+
+  template <class Rep, class Period>
+  explicit bp_ttl(std::chrono::duration<Rep, Period> ttl, std::size_t capacity = 1024,
+                  ttl_stale stale = ttl_stale::drop)
+    : ttl_(std::chrono::duration_cast<typename clock::duration>(ttl)),
+      cap_(capacity ? capacity : 1), stale_(stale) {}
+  bp_ttl(const bp_ttl& o) : ttl_(o.ttl_), cap_(o.cap_), stale_(o.stale_) {}
+
+  template <class Executor, class Invoke>
+  void publish(const T& v, Executor& ex, Invoke invoke) {
+    bool should_schedule = false;
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      if (q_.size() < cap_) {
+        q_.push_back(item{v, clock::now()});
+        stats_.accepted();
+        stats_.depth(q_.size());
+        if (!scheduled_) { scheduled_ = true; should_schedule = true; }
+      } else {
+        stats_.dropped();
+      }
+    }
+
+    if (should_schedule) {
+      ex.post([this, inv = std::move(invoke)]() mutable {
+        std::optional<T> newest_stale;
+        for (;;) {
+          std::optional<T> fresh;
+          {
+            std::lock_guard<std::mutex> lock(m_);
+            const auto now = clock::now();
+            while (!q_.empty()) {
+              item& front = q_.front();
+              if (now - front.ts <= ttl_) {
+                fresh.emplace(std::move(front.value));
+                q_.pop_front();
+                break;
+              }
+              if (stale_ == ttl_stale::newest) {
+                if (newest_stale) stats_.expired();
+                newest_stale.emplace(std::move(front.value));
+              } else {
+                stats_.expired();
+              }
+              q_.pop_front();
+            }
+            stats_.depth(q_.size());
+            if (!fresh) {
+              if (!newest_stale) { scheduled_ = false; break; }
+            } else if (newest_stale) {
+              stats_.expired(); // superseded by a fresh event
+              newest_stale.reset();
+            }
+          }
+          if (fresh) {
+            inv(*fresh);
+          } else {
+            // Queue drained with only stale events: deliver the newest, then
+            // look again (more may have arrived meanwhile)
+            std::optional<T> last;
+            last.swap(newest_stale);
+            inv(*last);
+          }
+        }
+      });
+    }
+  }
+
+  bp_stats stats() const noexcept { return stats_.snapshot(); }
+
+private:
+  struct item {
+    T value;
+    typename clock::time_point ts;
+  };
+
+  typename clock::duration ttl_;
+  std::size_t cap_;
+  ttl_stale stale_;
+  std::mutex m_;
+  std::deque<item> q_;
+  bool scheduled_{false};
+  [[no_unique_address]] detail::bp_counters stats_;
+};
+
+// ── Adaptive: buffer while the consumer keeps up, conflate while it lags ─────────
+// Lossless FIFO buffering (like bp_buffer) as long as the consumer keeps up. When
+// it falls behind - the buffer is full, the oldest queued event is older than
+// max_lag, or the backlog would take longer than max_lag at the measured drain
+// rate - the stale backlog is discarded and delivery degrades to latest-only or
+// to one in `sample_every` events. Buffering resumes once the consumer has
+// caught up (nothing pending and the last delivery waited at most recover_lag).
+// on_mode_change(new_mode) runs on the thread that switched the mode, outside
+// of the policy's lock.
+enum class bp_mode { buffer, latest, sample };
+
+struct bp_adaptive_options {
+  std::size_t capacity{1024};
+  std::chrono::steady_clock::duration max_lag{std::chrono::milliseconds(10)};
+  std::chrono::steady_clock::duration recover_lag{std::chrono::milliseconds(1)};
+  bp_mode degraded{bp_mode::latest};   // latest or sample
+  std::size_t sample_every{10};
+  std::function<void(bp_mode)> on_mode_change{};
+};
+
+template <class T>
+class bp_adaptive {
+public:
+  using clock = std::chrono::steady_clock;
+
+  explicit bp_adaptive(bp_adaptive_options opts = {}) : opts_(std::move(opts)) {
+    if (opts_.capacity == 0) opts_.capacity = 1;
+    if (opts_.sample_every == 0) opts_.sample_every = 1;
+    if (opts_.degraded == bp_mode::buffer) opts_.degraded = bp_mode::latest;
+    if (opts_.recover_lag > opts_.max_lag) opts_.recover_lag = opts_.max_lag;
+  }
+  bp_adaptive(const bp_adaptive& o) : bp_adaptive(o.opts_) {}
+
+  template <class Executor, class Invoke>
+  void publish(const T& v, Executor& ex, Invoke invoke) {
+    const auto now = clock::now();
+    bool should_schedule = false;
+    bool changed = false;
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      if (mode_ == bp_mode::buffer && lagging(now)) {
+        stats_.coalesced(q_.size()); // the backlog is stale: drop it
+        q_.clear();
+        seen_ = 0;
+        set_mode(opts_.degraded);
+        changed = true;
+      }
+
+      switch (mode_) {
+        case bp_mode::buffer:
+          q_.push_back(item{v, now});
+          stats_.accepted();
+          break;
+        case bp_mode::latest:
+          if (last_) stats_.coalesced();
+          last_.emplace(item{v, now});
+          stats_.accepted();
+          break;
+        case bp_mode::sample:
+          if (seen_++ % opts_.sample_every == 0 && q_.size() < opts_.capacity) {
+            q_.push_back(item{v, now});
+            stats_.accepted();
+          } else {
+            stats_.dropped();
+          }
+          break;
+      }
+      stats_.depth(pending());
+      if (!scheduled_) { scheduled_ = true; should_schedule = true; }
+    }
+    if (changed) notify();
+
+    if (should_schedule) {
+      ex.post([this, inv = std::move(invoke)]() mutable {
+        std::optional<clock::time_point> prev_pick;
+        for (;;) {
+          std::optional<item> it;
+          bool recovered = false;
+          {
+            std::lock_guard<std::mutex> lock(m_);
+            if (!q_.empty()) {
+              it.emplace(std::move(q_.front()));
+              q_.pop_front();
+            } else if (last_) {
+              it.swap(last_);
+            } else {
+              scheduled_ = false;
+              break;
+            }
+            const auto picked_at = clock::now();
+            // Back-to-back deliveries measure the consumer's service time
+            if (prev_pick) {
+              const auto sample = (picked_at - *prev_pick).count();
+              service_ = service_ ? service_ - service_ / 8 + sample / 8 : sample;
+            }
+            prev_pick = picked_at;
+            if (mode_ != bp_mode::buffer && pending() == 0 &&
+                picked_at - it->ts <= opts_.recover_lag) {
+              set_mode(bp_mode::buffer);
+              recovered = true;
+            }
+            stats_.depth(pending());
+          }
+          if (recovered) notify();
+          inv(it->value);
+        }
+      });
+    }
+  }
+
+  bp_mode mode() const noexcept { return mode_atomic_.load(std::memory_order_acquire); }
+
+  // Measured consumer throughput in events per second (0 until measured)
+  double drain_rate() const {
+    std::lock_guard<std::mutex> lock(m_);
+    if (service_ <= 0) return 0.0;
+    return 1.0 / std::chrono::duration<double>(clock::duration(service_)).count();
+  }
+
+  bp_stats stats() const noexcept { return stats_.snapshot(); }
+
+private:
+  struct item {
+    T value;
+    clock::time_point ts;
+  };
+
+  // Called under m_
+  bool lagging(clock::time_point now) const {
+    if (q_.empty()) return false;
+    if (q_.size() >= opts_.capacity) return true;
+    if (now - q_.front().ts > opts_.max_lag) return true;
+    const clock::duration backlog(static_cast<clock::rep>(q_.size()) * service_);
+    return service_ > 0 && backlog > opts_.max_lag;
+  }
+
+  std::size_t pending() const { return q_.size() + (last_ ? 1 : 0); }
+
+  void set_mode(bp_mode m) {
+    mode_ = m;
+    mode_atomic_.store(m, std::memory_order_release);
+  }
+
+  void notify() {
+    if (opts_.on_mode_change) opts_.on_mode_change(mode());
+  }
+
+  bp_adaptive_options opts_;
+  mutable std::mutex m_;
+  std::deque<item> q_;
+  std::optional<item> last_;     // latest mode
+  std::size_t seen_{0};          // sample mode
+  bp_mode mode_{bp_mode::buffer};
+  std::atomic<bp_mode> mode_atomic_{bp_mode::buffer};
+  clock::rep service_{0};        // EWMA of the time per delivery, in clock ticks
+  bool scheduled_{false};
+  [[no_unique_address]] detail::bp_counters stats_;
 };
 
 // ── "Buffer for N events" (compiler knows the capacity) ──────────────────────────
@@ -123,9 +660,12 @@ public:
       std::lock_guard<std::mutex> lock(m_);
       if (q_.size() < N) {
         q_.push_back(v);
+        stats_.accepted();
+        stats_.depth(q_.size());
         if (!scheduled_) { scheduled_ = true; should_schedule = true; }
       } else {
         // the buffer is full - drop
+        stats_.dropped();
       }
     }
     if (should_schedule) {
@@ -137,16 +677,19 @@ public:
             if (q_.empty()) { scheduled_ = false; break; }
             item.emplace(std::move(q_.front()));
             q_.pop_front();
+            stats_.depth(q_.size());
           }
           inv(*item);
         }
       });
     }
   }
+  bp_stats stats() const noexcept { return stats_.snapshot(); }
 private:
   std::mutex m_;
   std::deque<T> q_;
   bool scheduled_{false};
+  [[no_unique_address]] detail::bp_counters stats_;
 };
 
 // ── "Package of N events" (like a mini-batch by quantity) ────────────────────────
@@ -162,6 +705,8 @@ public:
     {
       std::lock_guard<std::mutex> lock(m_);
       buf_.push_back(v);
+      stats_.accepted();
+      stats_.depth(buf_.size());
       if (buf_.size() == N && !scheduled_) {
         scheduled_ = true;
         should_flush = true;
@@ -180,6 +725,7 @@ public:
               local[i] = std::move(buf_.front());
               buf_.pop_front();
             }
+            stats_.depth(buf_.size());
             count = N;
           }
           for (std::size_t i = 0; i < count; ++i) inv(local[i]);
@@ -187,10 +733,12 @@ public:
       });
     }
   }
+  bp_stats stats() const noexcept { return stats_.snapshot(); }
 private:
   std::mutex m_;
   std::deque<T> buf_;
   bool scheduled_{false};
+  [[no_unique_address]] detail::bp_counters stats_;
 };
 
 // Accumulates up to N elements and calls the handler N times in a single run.
@@ -207,6 +755,8 @@ public:
     {
       std::lock_guard<std::mutex> lock(m_);
       buf_.push_back(v);
+      stats_.accepted();
+      stats_.depth(buf_.size());
 
       // if we have collected exactly N, we will schedule a batch dump
       if (buf_.size() == N && !scheduled_batch_) {
@@ -255,6 +805,8 @@ public:
     }
   }
 
+  bp_stats stats() const noexcept { return stats_.snapshot(); }
+
 private:
   using clock = std::chrono::steady_clock;
 
@@ -268,6 +820,7 @@ private:
         local[i] = std::move(buf_.front());
         buf_.pop_front();
       }
+      stats_.depth(buf_.size());
       scheduled_batch_ = false;
     }
     for (std::size_t i = 0; i < N; ++i) inv(local[i]);
@@ -280,6 +833,7 @@ private:
     {
       std::lock_guard<std::mutex> lock(m_);
       local.swap(buf_);
+      stats_.depth(0);
       scheduled_timeout_ = false;
     }
     for (auto& x : local) inv(x);
@@ -291,6 +845,7 @@ private:
   bool scheduled_timeout_{false};
   bool timer_armed_{false};
   clock::time_point last_push_{};
+  [[no_unique_address]] detail::bp_counters stats_;
 };
 
 
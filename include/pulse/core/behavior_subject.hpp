@@ -0,0 +1,37 @@
+#pragma once
+#include <pulse/core/observable.hpp>
+#include <pulse/core/latest_cell.hpp>
+#include <pulse/core/replay_subject.hpp>
+#include <exception>
+#include <utility>
+
+namespace pulse {
+
+// behavior_subject<T>: subject with a current value.
+// - every new subscriber first receives the current value, then live events;
+// - value() reads the current value from any thread without subscribing
+//   and without blocking producers (see latest_cell).
+template <class T>
+class behavior_subject {
+public:
+  explicit behavior_subject(T initial) : latest_(initial) { subj_.on_next(initial); }
+
+  behavior_subject(const behavior_subject&) = delete;
+  behavior_subject& operator=(const behavior_subject&) = delete;
+
+  observable<T> as_observable() { return subj_.as_observable(); }
+
+  // Current value (the last on_next, or the initial one)
+  T value() const { return *latest_.load(); }
+
+  // push-API
+  void on_next(const T& v) { subj_.push(v, [&]{ latest_.store(v); }); }
+  void on_error(std::exception_ptr e) { subj_.on_error(e); }
+  void on_completed() { subj_.on_completed(); }
+
+private:
+  latest_cell<T> latest_;
+  replay_subject<T> subj_{1};
+};
+
+} // namespace pulse
@@ -0,0 +1,89 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Backpressure telemetry. Configured by CMake (option PULSE_TELEMETRY);
+// header-only users can define PULSE_TELEMETRY=0 to compile the counters out.
+#ifndef PULSE_TELEMETRY
+#define PULSE_TELEMETRY 1
+#endif
+
+namespace pulse {
+
+// Snapshot of one policy's counters (all zero when telemetry is compiled out).
+// - accepted:   events taken in (queued, conflated or passed through)
+// - dropped:    events discarded by the policy
+// - coalesced:  events overwritten by a fresher one before delivery
+// - expired:    events discarded because they waited longer than their TTL
+// - depth:      events currently waiting for delivery
+// - high_water: largest depth seen so far
+struct bp_stats {
+  static constexpr bool enabled = PULSE_TELEMETRY != 0;
+
+  std::uint64_t accepted{0};
+  std::uint64_t dropped{0};
+  std::uint64_t coalesced{0};
+  std::uint64_t expired{0};
+  std::size_t depth{0};
+  std::size_t high_water{0};
+};
+
+namespace detail {
+
+#if PULSE_TELEMETRY
+// Relaxed counters updated on the policy's hot path; readable from any thread.
+// A copy starts from zero, so copying a policy copies its configuration only.
+class bp_counters {
+public:
+  bp_counters() = default;
+  bp_counters(const bp_counters&) noexcept {}
+  bp_counters& operator=(const bp_counters&) noexcept { return *this; }
+
+  void accepted(std::uint64_t n = 1) noexcept { accepted_.fetch_add(n, std::memory_order_relaxed); }
+  void dropped(std::uint64_t n = 1) noexcept { dropped_.fetch_add(n, std::memory_order_relaxed); }
+  void coalesced(std::uint64_t n = 1) noexcept { coalesced_.fetch_add(n, std::memory_order_relaxed); }
+  void expired(std::uint64_t n = 1) noexcept { expired_.fetch_add(n, std::memory_order_relaxed); }
+
+  // Current queue depth; also raises the high-water mark
+  void depth(std::size_t d) noexcept {
+    depth_.store(d, std::memory_order_relaxed);
+    std::size_t hw = high_water_.load(std::memory_order_relaxed);
+    while (d > hw &&
+           !high_water_.compare_exchange_weak(hw, d, std::memory_order_relaxed)) {}
+  }
+
+  bp_stats snapshot() const noexcept {
+    return bp_stats{accepted_.load(std::memory_order_relaxed),
+                    dropped_.load(std::memory_order_relaxed),
+                    coalesced_.load(std::memory_order_relaxed),
+                    expired_.load(std::memory_order_relaxed),
+                    depth_.load(std::memory_order_relaxed),
+                    high_water_.load(std::memory_order_relaxed)};
+  }
+
+private:
+  std::atomic<std::uint64_t> accepted_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<std::uint64_t> coalesced_{0};
+  std::atomic<std::uint64_t> expired_{0};
+  std::atomic<std::size_t> depth_{0};
+  std::atomic<std::size_t> high_water_{0};
+};
+#else
+// Telemetry compiled out: empty, every call is a no-op.
+class bp_counters {
+public:
+  void accepted(std::uint64_t = 1) noexcept {}
+  void dropped(std::uint64_t = 1) noexcept {}
+  void coalesced(std::uint64_t = 1) noexcept {}
+  void expired(std::uint64_t = 1) noexcept {}
+  void depth(std::size_t) noexcept {}
+  bp_stats snapshot() const noexcept { return {}; }
+};
+static_assert(std::is_empty_v<bp_counters>);
+#endif
+
+} // namespace detail
+} // namespace pulse
@@ -0,0 +1,115 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <pulse/core/subscription.hpp>
+
+namespace pulse {
+
+// cancel_group: the set of tasks one owner (usually one subscription) has posted
+// to executors. After cancel() none of the tasks that have not started yet will run,
+// and every later post with this group is dropped.
+//
+// Executors that keep their own queue (thread_pool) register queued tasks as hooks,
+// so cancel() unlinks them from the queue in O(1) each instead of letting a worker
+// pop a dead closure. Other executors get the generic fallback of executor::post
+// (the task checks cancelled() before running).
+class cancel_group {
+public:
+  // Executor-side handle of one queued task.
+  class task_hook {
+  public:
+    task_hook() = default;
+    task_hook(const task_hook&) = delete;
+    task_hook& operator=(const task_hook&) = delete;
+
+  protected:
+    ~task_hook() = default;
+
+    // Called by cancel() under the group lock. Returns true if the executor has
+    // claimed the task for cancellation and unlinked it from its queue, false if the
+    // task already started - the executor will detach() it when it finishes.
+    virtual bool cancel_pending() noexcept = 0;
+
+    // Frees a task claimed by cancel_pending(); called outside the group lock
+    // (destroying the closure may run arbitrary destructors).
+    virtual void dispose() noexcept = 0;
+
+  private:
+    friend class cancel_group;
+    task_hook* prev_{nullptr};
+    task_hook* next_{nullptr};
+    bool linked_{false};
+  };
+
+  cancel_group() = default;
+  cancel_group(const cancel_group&) = delete;
+  cancel_group& operator=(const cancel_group&) = delete;
+
+  bool cancelled() const noexcept { return cancelled_.load(std::memory_order_acquire); }
+
+  // Drops all pending tasks of the group. Repeated calls are no-op.
+  void cancel() noexcept {
+    if (cancelled()) return;
+    task_hook* claimed = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      if (cancelled_.exchange(true, std::memory_order_acq_rel)) return;
+      for (task_hook* t = head_; t != nullptr;) {
+        task_hook* next = t->next_;
+        t->prev_ = t->next_ = nullptr;
+        t->linked_ = false;
+        if (t->cancel_pending()) {
+          t->next_ = claimed;
+          claimed = t;
+        }
+        t = next;
+      }
+      head_ = nullptr;
+    }
+    while (claimed) {
+      task_hook* next = claimed->next_;
+      claimed->dispose();
+      claimed = next;
+    }
+  }
+
+  // Executor side: links the hook and runs `enqueue` under the group lock, so that
+  // cancel() either sees the task in the executor queue or the post is rejected.
+  // Returns false (nothing enqueued) if the group is already cancelled.
+  template <class Enqueue>
+  bool attach(task_hook& t, Enqueue&& enqueue) {
+    std::lock_guard<std::mutex> lock(m_);
+    if (cancelled_.load(std::memory_order_relaxed)) return false;
+    t.prev_ = nullptr;
+    t.next_ = head_;
+    if (head_) head_->prev_ = &t;
+    head_ = &t;
+    t.linked_ = true;
+    std::forward<Enqueue>(enqueue)();
+    return true;
+  }
+
+  // Executor side: forget a task that has started (or finished) running.
+  void detach(task_hook& t) noexcept {
+    std::lock_guard<std::mutex> lock(m_);
+    if (!t.linked_) return;
+    if (t.prev_) t.prev_->next_ = t.next_; else head_ = t.next_;
+    if (t.next_) t.next_->prev_ = t.prev_;
+    t.prev_ = t.next_ = nullptr;
+    t.linked_ = false;
+  }
+
+private:
+  std::mutex m_;
+  std::atomic<bool> cancelled_{false};
+  task_hook* head_{nullptr};
+};
+
+// Subscription that cancels the group on reset().
+inline subscription make_subscription(std::shared_ptr<cancel_group> g) {
+  return subscription([g = std::move(g)]{ g->cancel(); });
+}
+
+} // namespace pulse
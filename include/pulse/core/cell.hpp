@@ -0,0 +1,310 @@
+#pragma once
+#include <pulse/core/observable.hpp>
+#include <pulse/core/multicast_hub.hpp>
+#include <pulse/core/subscription.hpp>
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pulse {
+
+class cell_graph;
+
+namespace detail {
+
+// A vertex of a cell_graph. rank is 0 for input cells and 1 + the highest rank
+// of the dependencies for computed ones; dependencies are fixed at construction,
+// so visiting dirty nodes by ascending rank visits every node after all of its
+// inputs. Every field is guarded by the graph lock.
+struct cell_node {
+  cell_node(cell_graph* g, std::size_t r) : graph(g), rank(r) {}
+  virtual ~cell_node() = default;
+
+  // Re-evaluates the node from its dependencies; true if the value changed
+  virtual bool recompute() { return false; }
+  // Hands the current value to the observers
+  virtual void publish() = 0;
+
+  cell_graph* const graph;
+  const std::size_t rank;
+  std::vector<std::weak_ptr<cell_node>> dependents;
+  bool queued{false};   // waiting for recompute() in the current commit
+  bool changed{false};  // waiting for publish() in the current commit
+};
+
+template <class T> struct cell_value_node;
+
+// Stores v; false if it compares equal to the current value
+template <class T>
+bool cell_assign(T& slot, T&& v) {
+  if constexpr (std::equality_comparable<T>) {
+    if (slot == v) return false;
+  }
+  slot = std::move(v);
+  return true;
+}
+
+} // namespace detail
+
+// cell_graph: propagation context for cell<T> and computed<T>. A write starts a
+// transaction; its commit recomputes the affected computed cells by ascending
+// rank (each one at most once, and only if one of its inputs really changed)
+// and then notifies the observers of every changed cell. Neither a computation
+// nor an observer ever sees a mix of old and new inputs.
+//
+// Commits are serialized by one recursive lock and run on the writing thread,
+// observers included - keep them short or add observe_on. A set() issued while
+// a commit runs (by an observer or a computation), also inside a transaction(),
+// is applied after the current round of notifications, as a follow-up round of
+// the same commit.
+class cell_graph {
+public:
+  cell_graph() = default;
+  cell_graph(const cell_graph&) = delete;
+  cell_graph& operator=(const cell_graph&) = delete;
+
+  // Runs fn with the graph locked; every set() inside becomes part of one
+  // transaction, committed when the outermost transaction() returns (also when
+  // fn throws: the writes made so far are propagated). Inside fn computed cells
+  // still hold the values of the previous commit.
+  template <class Fn>
+  void transaction(Fn&& fn) {
+    std::lock_guard<std::recursive_mutex> lock(m_);
+    ++depth_;
+    try {
+      std::forward<Fn>(fn)();
+    } catch (...) {
+      if (--depth_ == 0 && !committing_) commit();
+      throw;
+    }
+    // Opened by an observer or a computation: its writes were deferred and
+    // the running commit applies them as its next round
+    if (--depth_ == 0 && !committing_) commit();
+  }
+
+  // Evaluations of computed cells so far (construction included)
+  std::size_t recomputations() const {
+    std::lock_guard<std::recursive_mutex> lock(m_);
+    return recomputations_;
+  }
+
+private:
+  template <class> friend class cell;
+  template <class> friend class computed;
+  template <class> friend struct detail::cell_value_node;
+
+  using node_ptr = std::shared_ptr<detail::cell_node>;
+
+  struct by_rank {
+    bool operator()(const node_ptr& a, const node_ptr& b) const { return a->rank > b->rank; }
+  };
+
+  // n got a new value: schedule its dependents and its notification (under m_)
+  void touched(const node_ptr& n) {
+    if (!n->changed) {
+      n->changed = true;
+      notify_.push_back(n);
+    }
+    auto& deps = n->dependents;
+    std::size_t live = 0;
+    for (std::size_t i = 0; i < deps.size(); ++i) {
+      auto d = deps[i].lock();
+      if (!d) continue;                       // dependent destroyed: drop the edge
+      if (live != i) deps[live] = deps[i];
+      ++live;
+      if (!d->queued) {
+        d->queued = true;
+        dirty_.push_back(std::move(d));
+        std::push_heap(dirty_.begin(), dirty_.end(), by_rank{});
+      }
+    }
+    deps.resize(live);
+  }
+
+  // Input write: applied now, or after the current round if a commit is running
+  template <class T>
+  void write(const std::shared_ptr<detail::cell_value_node<T>>& n, T v) {
+    std::lock_guard<std::recursive_mutex> lock(m_);
+    if (committing_) {
+      deferred_.push_back([this, n, v = std::move(v)]() mutable {
+        if (detail::cell_assign(n->value, std::move(v))) touched(n);
+      });
+      return;
+    }
+    if (!detail::cell_assign(n->value, std::move(v))) return;
+    touched(n);
+    if (depth_ == 0) commit();
+  }
+
+  void commit() {
+    committing_ = true;
+    try {
+      while (!dirty_.empty() || !notify_.empty() || !deferred_.empty()) {
+        while (!dirty_.empty()) {
+          std::pop_heap(dirty_.begin(), dirty_.end(), by_rank{});
+          node_ptr n = std::move(dirty_.back());
+          dirty_.pop_back();
+          n->queued = false;
+          ++recomputations_;
+          if (n->recompute()) touched(n);
+        }
+        // inputs first, then by rank: the order the values were settled in
+        auto batch = std::move(notify_);
+        notify_.clear();
+        for (auto& n : batch) n->changed = false;
+        for (auto& n : batch) n->publish();
+
+        auto writes = std::move(deferred_);
+        deferred_.clear();
+        for (auto& w : writes) w();
+      }
+    } catch (...) {
+      abandon();
+      throw;
+    }
+    committing_ = false;
+  }
+
+  // A computation or an observer threw: drop the rest of the commit
+  void abandon() {
+    for (auto& n : dirty_) n->queued = false;
+    dirty_.clear();
+    for (auto& n : notify_) n->changed = false;
+    notify_.clear();
+    deferred_.clear();
+    committing_ = false;
+  }
+
+  mutable std::recursive_mutex m_;
+  int depth_{0};                                   // nested transaction() calls
+  bool committing_{false};
+  std::size_t recomputations_{0};
+  std::vector<node_ptr> dirty_;                    // min-heap by rank
+  std::vector<node_ptr> notify_;
+  std::vector<std::function<void()>> deferred_;
+};
+
+namespace detail {
+
+template <class T>
+struct cell_value_node : cell_node {
+  cell_value_node(cell_graph* g, std::size_t r, T v) : cell_node(g, r), value(std::move(v)) {}
+
+  void publish() override { observers.on_next(value); }
+
+  // Current value first, then every committed change; never terminates
+  static observable<T> observe(std::shared_ptr<cell_value_node> n) {
+    return observable<T>::create([n](auto on_next, auto on_err, auto on_done){
+      std::lock_guard<std::recursive_mutex> lock(n->graph->m_);
+      auto first = on_next;
+      auto h = n->observers.add(std::move(on_next), std::move(on_err), std::move(on_done));
+      if (first) {
+        T v = n->value;
+        first(v);
+      }
+      return subscription([n, h]{ n->observers.remove(h); });
+    });
+  }
+
+  T value;
+  multicast_hub<T> observers;
+};
+
+template <class T, class F, class... Vs>
+struct computed_node : cell_value_node<T> {
+  computed_node(cell_graph* g, std::size_t r, F fn, std::shared_ptr<cell_value_node<Vs>>... d)
+    : cell_value_node<T>(g, r, T(fn(std::as_const(d->value)...))),
+      f(std::move(fn)), deps(std::move(d)...) {}
+
+  bool recompute() override {
+    return cell_assign(this->value, std::apply([this](const auto&... d){
+      return T(f(std::as_const(d->value)...));
+    }, deps));
+  }
+
+  F f;
+  std::tuple<std::shared_ptr<cell_value_node<Vs>>...> deps; // keeps the inputs alive
+};
+
+} // namespace detail
+
+// cell<T>: an input of a cell_graph. Copies are handles to the same cell.
+// set() with a value equal to the current one (if T has ==) is a no-op.
+template <class T>
+class cell {
+public:
+  using value_type = T;
+
+  cell(cell_graph& g, T initial)
+    : node_(std::make_shared<detail::cell_value_node<T>>(&g, 0, std::move(initial))) {}
+
+  T get() const {
+    std::lock_guard<std::recursive_mutex> lock(node_->graph->m_);
+    return node_->value;
+  }
+
+  // Commits at once, or with the enclosing cell_graph::transaction()
+  void set(T v) { node_->graph->write(node_, std::move(v)); }
+
+  // Current value to every new subscriber, then each committed change
+  observable<T> as_observable() const { return detail::cell_value_node<T>::observe(node_); }
+
+  const std::shared_ptr<detail::cell_value_node<T>>& node() const noexcept { return node_; }
+
+private:
+  std::shared_ptr<detail::cell_value_node<T>> node_;
+};
+
+// computed<T>(f, deps...): a cell holding f(deps' values...). deps are cells or
+// other computed cells of the same graph; the graph recomputes it once per
+// commit in which at least one of them changed, and keeps its dependents
+// untouched when the result compares equal to the previous one. f must not
+// have side effects on the graph. With CTAD, `computed c(f, a, b)` deduces T
+// from f.
+template <class T>
+class computed {
+public:
+  using value_type = T;
+
+  template <class F, class... Deps>
+    requires (sizeof...(Deps) >= 1)
+  explicit computed(F f, const Deps&... deps) {
+    cell_graph* g = std::get<0>(std::tie(deps...)).node()->graph;
+    if (((deps.node()->graph != g) || ...))
+      throw std::invalid_argument("computed: dependencies belong to different cell graphs");
+
+    std::lock_guard<std::recursive_mutex> lock(g->m_);
+    const std::size_t rank = 1 + std::max({ deps.node()->rank... });
+    auto n = std::make_shared<detail::computed_node<T, F, typename Deps::value_type...>>(
+      g, rank, std::move(f), deps.node()...);
+    ++g->recomputations_;
+    (deps.node()->dependents.push_back(n), ...);
+    node_ = std::move(n);
+  }
+
+  T get() const {
+    std::lock_guard<std::recursive_mutex> lock(node_->graph->m_);
+    return node_->value;
+  }
+
+  observable<T> as_observable() const { return detail::cell_value_node<T>::observe(node_); }
+
+  const std::shared_ptr<detail::cell_value_node<T>>& node() const noexcept { return node_; }
+
+private:
+  std::shared_ptr<detail::cell_value_node<T>> node_;
+};
+
+template <class F, class... Deps>
+computed(F, const Deps&...)
+  -> computed<std::decay_t<std::invoke_result_t<F&, const typename Deps::value_type&...>>>;
+
+} // namespace pulse
@@ -0,0 +1,157 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace pulse {
+
+// CPU/NUMA layout of the machine as seen by the current process.
+// On Linux it is read from sysfs (/sys/devices/system/node/node*/cpulist) and
+// restricted to the CPUs the process is allowed to run on (sched_getaffinity).
+// Elsewhere (or if sysfs is unavailable) it degrades to one node with all CPUs.
+struct cpu_topology {
+  // nodes[i] = sorted CPU ids of NUMA node i (only non-empty nodes are kept)
+  std::vector<std::vector<int>> nodes;
+
+  std::size_t cpu_count() const noexcept {
+    std::size_t n = 0;
+    for (auto& cpus : nodes) n += cpus.size();
+    return n;
+  }
+
+  // Index in `nodes` of the node owning `cpu`, or -1 if unknown.
+  int node_of(int cpu) const noexcept {
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+      if (std::binary_search(nodes[i].begin(), nodes[i].end(), cpu))
+        return static_cast<int>(i);
+    }
+    return -1;
+  }
+
+  // Keep only the given CPUs (nodes that become empty are removed).
+  cpu_topology restricted_to(std::vector<int> cpus) const {
+    std::sort(cpus.begin(), cpus.end());
+    cpu_topology out;
+    for (auto& node : nodes) {
+      std::vector<int> kept;
+      std::set_intersection(node.begin(), node.end(), cpus.begin(), cpus.end(),
+                            std::back_inserter(kept));
+      if (!kept.empty()) out.nodes.push_back(std::move(kept));
+    }
+    return out;
+  }
+
+  static cpu_topology detect();
+};
+
+namespace detail {
+
+// Parses the kernel cpulist format: "0-3,8,10-11" -> {0,1,2,3,8,10,11}
+inline std::vector<int> parse_cpulist(std::string_view s) {
+  std::vector<int> out;
+  std::size_t i = 0;
+  auto read_int = [&](int& v) {
+    std::size_t start = i;
+    v = 0;
+    while (i < s.size() && s[i] >= '0' && s[i] <= '9') {
+      v = v * 10 + (s[i] - '0');
+      ++i;
+    }
+    return i > start;
+  };
+  while (i < s.size()) {
+    int a = 0;
+    if (!read_int(a)) { ++i; continue; } // skip separators/whitespace
+    int b = a;
+    if (i < s.size() && s[i] == '-') {
+      ++i;
+      if (!read_int(b)) b = a;
+    }
+    for (int c = a; c <= b; ++c) out.push_back(c);
+  }
+  std::sort(out.begin(), out.end());
+  out.erase(std::unique(out.begin(), out.end()), out.end());
+  return out;
+}
+
+// CPUs the calling thread may run on.
+inline std::vector<int> allowed_cpus() {
+  std::vector<int> out;
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (int c = 0; c < CPU_SETSIZE; ++c)
+      if (CPU_ISSET(c, &set)) out.push_back(c);
+  }
+#endif
+  if (out.empty()) {
+    const unsigned n = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned c = 0; c < n; ++c) out.push_back(static_cast<int>(c));
+  }
+  return out;
+}
+
+} // namespace detail
+
+inline cpu_topology cpu_topology::detect() {
+  cpu_topology topo;
+#if defined(__linux__)
+  // Node ids may be sparse (node0, node2, ...) - take them from the "online" mask.
+  std::ifstream online("/sys/devices/system/node/online");
+  std::string ids;
+  if (online && std::getline(online, ids)) {
+    for (int node : detail::parse_cpulist(ids)) {
+      std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+      std::string line;
+      if (!in || !std::getline(in, line)) continue;
+      auto cpus = detail::parse_cpulist(line);
+      if (!cpus.empty()) topo.nodes.push_back(std::move(cpus));
+    }
+  }
+#endif
+  auto allowed = detail::allowed_cpus();
+  if (topo.nodes.empty()) {
+    topo.nodes.push_back(allowed);
+    return topo;
+  }
+  auto restricted = topo.restricted_to(allowed);
+  if (restricted.nodes.empty()) restricted.nodes.push_back(std::move(allowed));
+  return restricted;
+}
+
+// CPU the calling thread is currently running on, or -1 if unknown.
+inline int current_cpu() noexcept {
+#if defined(__linux__)
+  return sched_getcpu();
+#else
+  return -1;
+#endif
+}
+
+// Restricts the calling thread to `cpus`. Returns false if unsupported or rejected.
+inline bool pin_current_thread(const std::vector<int>& cpus) noexcept {
+#if defined(__linux__)
+  if (cpus.empty()) return false;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int c : cpus) {
+    if (c >= 0 && c < CPU_SETSIZE) CPU_SET(c, &set);
+  }
+  return sched_setaffinity(0, sizeof(set), &set) == 0; // 0 = calling thread
+#else
+  (void)cpus;
+  return false;
+#endif
+}
+
+} // namespace pulse
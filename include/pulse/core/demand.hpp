@@ -0,0 +1,230 @@
+#pragma once
+#include <pulse/core/observable.hpp>
+#include <pulse/core/multicast_hub.hpp>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace pulse {
+
+// demand: Reactive Streams-style credit between a subscriber and its source.
+//
+//   auto d = std::make_shared<demand>();
+//   auto sub = obs.subscribe([&](const T& v){ process(v); d->request(1); }, {}, {}, d);
+//   d->request(16);
+//
+// The subscriber grants credit with request(n); a demand-aware source emits at most
+// that many values (terminal events need no credit). request(demand::unbounded)
+// switches flow control off. Sources created with observable::create (not
+// create_flow) do not know about demand and emit without limit.
+class demand {
+public:
+  static constexpr std::size_t unbounded = std::numeric_limits<std::size_t>::max();
+
+  using listener = multicast_hub<std::size_t>::handle;
+
+  demand() = default;
+  demand(const demand&) = delete;
+  demand& operator=(const demand&) = delete;
+
+  // Grants n more values (saturates at unbounded) and wakes the source(s).
+  void request(std::size_t n) {
+    if (n == 0) return;
+    std::size_t cur = credit_.load(std::memory_order_relaxed);
+    std::size_t next;
+    do {
+      next = (cur > unbounded - n) ? unbounded : cur + n;
+    } while (!credit_.compare_exchange_weak(cur, next, std::memory_order_acq_rel,
+                                            std::memory_order_relaxed));
+    listeners_.on_next(n);
+  }
+
+  // Source side: takes one unit of credit if there is any.
+  bool try_consume() noexcept {
+    std::size_t cur = credit_.load(std::memory_order_acquire);
+    for (;;) {
+      if (cur == 0) return false;
+      if (cur == unbounded) return true;
+      if (credit_.compare_exchange_weak(cur, cur - 1, std::memory_order_acq_rel,
+                                        std::memory_order_acquire))
+        return true;
+    }
+  }
+
+  // Operator side: takes all outstanding credit (to re-issue it upstream).
+  std::size_t take_all() noexcept { return credit_.exchange(0, std::memory_order_acq_rel); }
+
+  std::size_t outstanding() const noexcept { return credit_.load(std::memory_order_acquire); }
+
+  // Source side: f(n) runs on the requesting thread after every request(n).
+  listener on_request(std::function<void(std::size_t)> f) {
+    return listeners_.add([f = std::move(f)](const std::size_t& n){ f(n); }, {}, {});
+  }
+
+  void remove(const listener& l) { listeners_.remove(l); }
+
+private:
+  std::atomic<std::size_t> credit_{0};
+  multicast_hub<std::size_t> listeners_;
+};
+
+// Operators that re-issue downstream credit to their own upstream demands
+// (zip, concat_map): subscribes `forward` to d and hands over what d already has.
+inline demand::listener forward_demand(const std::shared_ptr<demand>& d,
+                                       std::function<void(std::size_t)> forward) {
+  auto l = d->on_request([w = std::weak_ptr<demand>(d), forward](std::size_t){
+    if (auto dd = w.lock()) if (auto n = dd->take_all()) forward(n);
+  });
+  if (auto n = d->take_all()) forward(n);
+  return l;
+}
+
+// What a flow-controlled subscriber of a hot source (subject, topic) does when
+// more than `capacity` values wait beyond its credit: drop the new value, keep
+// the latest ones (the oldest waiting value is evicted), or fail the subscriber
+// with std::overflow_error.
+enum class flow_overflow { drop, latest, error };
+
+struct flow_options {
+  std::size_t capacity{1024};
+  flow_overflow overflow{flow_overflow::drop};
+};
+
+namespace detail {
+
+// Per-subscriber credit gate for hot sources (subject, topic): pushes from any
+// thread are delivered while there is credit and buffered otherwise, up to
+// opts.capacity values; request(n) drains the buffer. Delivery is serialized.
+template <class T>
+class flow_gate : public std::enable_shared_from_this<flow_gate<T>> {
+public:
+  using OnNext = typename observable<T>::OnNext;
+  using OnErr  = typename observable<T>::OnErr;
+  using OnDone = typename observable<T>::OnDone;
+
+  flow_gate(OnNext on_next, OnErr on_err, OnDone on_done, std::shared_ptr<demand> d,
+            flow_options opts = {})
+    : on_next_(std::move(on_next)), on_err_(std::move(on_err)), on_done_(std::move(on_done)),
+      d_(std::move(d)), opts_(opts) {}
+
+  ~flow_gate() { close(); }
+
+  // Call once after construction (needs shared_from_this)
+  void open() {
+    std::weak_ptr<flow_gate> w = this->shared_from_this();
+    listener_ = d_->on_request([w](std::size_t){ if (auto g = w.lock()) g->drain(); });
+    drain();
+  }
+
+  // Stops delivery and detaches from the demand
+  void close() {
+    closed_.store(true, std::memory_order_release);
+    if (listener_) { d_->remove(listener_); listener_ = {}; }
+  }
+
+  void push_next(const T& v) { push(event{v, nullptr}); }
+  void push_error(std::exception_ptr e) { push(event{std::nullopt, e}); }
+  void push_done() { push(event{std::nullopt, nullptr}); }
+
+  // Values that could still be taken without exceeding the credit
+  std::size_t available() const {
+    const std::size_t credit = d_->outstanding();
+    if (credit == demand::unbounded) return credit;
+    std::lock_guard<std::mutex> lock(m_);
+    return credit > values_ ? credit - values_ : 0;
+  }
+
+private:
+  struct event {
+    std::optional<T> value; // empty for terminal events
+    std::exception_ptr error;
+  };
+
+  void push(event ev) {
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      if (failed_) return;
+      if (ev.value && beyond_credit() >= opts_.capacity) {
+        switch (opts_.overflow) {
+        case flow_overflow::drop:
+          return;
+        case flow_overflow::latest:
+          if (q_.empty() || !q_.front().value) return; // only a terminal event is waiting
+          q_.pop_front();
+          --values_;
+          break;
+        case flow_overflow::error:
+          // the buffered values are discarded, the error needs no credit
+          q_.clear();
+          values_ = 0;
+          failed_ = true;
+          ev = event{std::nullopt,
+                     std::make_exception_ptr(std::overflow_error("flow_gate: buffer overflow"))};
+          break;
+        }
+      }
+      if (ev.value) ++values_;
+      q_.push_back(std::move(ev));
+    }
+    drain();
+  }
+
+  // Buffered values the current credit does not cover (under m_)
+  std::size_t beyond_credit() const {
+    const std::size_t credit = d_->outstanding();
+    return values_ > credit ? values_ - credit : 0;
+  }
+
+  void drain() {
+    if (wip_.fetch_add(1, std::memory_order_acq_rel) != 0) return;
+    int missed = 1;
+    for (;;) {
+      for (;;) {
+        if (closed_.load(std::memory_order_acquire)) break;
+        std::optional<event> ev;
+        {
+          std::lock_guard<std::mutex> lock(m_);
+          if (q_.empty()) break;
+          if (q_.front().value) {
+            if (!d_->try_consume()) break;
+            --values_;
+          }
+          ev.emplace(std::move(q_.front()));
+          q_.pop_front();
+        }
+        if (ev->value) { if (on_next_) on_next_(*ev->value); }
+        else {
+          closed_.store(true, std::memory_order_release);
+          if (ev->error) { if (on_err_) on_err_(ev->error); }
+          else if (on_done_) on_done_();
+        }
+      }
+      missed = wip_.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+      if (missed == 0) break;
+    }
+  }
+
+  OnNext on_next_;
+  OnErr  on_err_;
+  OnDone on_done_;
+  std::shared_ptr<demand> d_;
+  const flow_options opts_;
+  demand::listener listener_;
+  mutable std::mutex m_;
+  std::deque<event> q_;
+  std::size_t values_{0};      // buffered values (not terminal events)
+  bool failed_{false};         // flow_overflow::error raised
+  std::atomic<int> wip_{0};
+  std::atomic<bool> closed_{false};
+};
+
+} // namespace detail
+} // namespace pulse
@@ -0,0 +1,93 @@
+#pragma once
+#include <pulse/core/utility.hpp>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <type_traits>
+
+namespace pulse {
+
+// latest_cell<T>: the most recent value of a stream, readable from any thread
+// without a subscription. Readers never block writers:
+// - trivially copyable T: seqlock, a reader retries if a write overlapped its copy;
+// - other T: the value lives behind an atomically swapped shared_ptr
+//   (one allocation per store, reads are a refcount increment).
+// Any number of writers is allowed.
+template <class T, bool = std::is_trivially_copyable_v<T>>
+class latest_cell {
+public:
+  latest_cell() = default;
+  explicit latest_cell(const T& v) { store(v); }
+
+  latest_cell(const latest_cell&) = delete;
+  latest_cell& operator=(const latest_cell&) = delete;
+
+  void store(const T& v) {
+    std::uint64_t ver = ver_.load(std::memory_order_relaxed);
+    for (;;) {
+      if (ver & 1) { // another writer is in
+        std::this_thread::yield();
+        ver = ver_.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (ver_.compare_exchange_weak(ver, ver + 1, std::memory_order_acquire,
+                                     std::memory_order_relaxed))
+        break;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(bytes_.data(), &v, sizeof(T));
+    ver_.store(ver + 2, std::memory_order_release);
+  }
+
+  std::optional<T> load() const {
+    std::array<unsigned char, sizeof(T)> copy;
+    for (;;) {
+      const std::uint64_t v1 = ver_.load(std::memory_order_acquire);
+      if (v1 == 0) return std::nullopt;
+      if (v1 & 1) continue;
+      std::memcpy(copy.data(), bytes_.data(), sizeof(T));
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (ver_.load(std::memory_order_relaxed) == v1) break;
+    }
+    return std::bit_cast<T>(copy);
+  }
+
+  bool has_value() const noexcept { return ver_.load(std::memory_order_acquire) != 0; }
+
+private:
+  std::atomic<std::uint64_t> ver_{0}; // 0 = empty, odd = write in progress
+  alignas(T) std::array<unsigned char, sizeof(T)> bytes_{};
+};
+
+template <class T>
+class latest_cell<T, false> {
+public:
+  latest_cell() = default;
+  explicit latest_cell(const T& v) { store(v); }
+
+  latest_cell(const latest_cell&) = delete;
+  latest_cell& operator=(const latest_cell&) = delete;
+
+  void store(const T& v) { p_.store(std::make_shared<const T>(v)); }
+
+  std::optional<T> load() const {
+    auto p = p_.load();
+    if (!p) return std::nullopt;
+    return *p;
+  }
+
+  // Shared snapshot without copying T
+  std::shared_ptr<const T> snapshot() const { return p_.load(); }
+
+  bool has_value() const noexcept { return static_cast<bool>(p_.load()); }
+
+private:
+  detail::atomic_shared<const T> p_;
+};
+
+} // namespace pulse
@@ -0,0 +1,179 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace pulse {
+
+// Snapshot of an lru_cache's counters.
+// - hits/misses: get() results (an expired entry counts as a miss)
+// - evictions:   entries pushed out because their shard was full
+// - expired:     entries dropped because they outlived the TTL
+// - size:        entries currently cached
+struct cache_stats {
+  std::uint64_t hits{0};
+  std::uint64_t misses{0};
+  std::uint64_t evictions{0};
+  std::uint64_t expired{0};
+  std::size_t size{0};
+};
+
+// Concurrent LRU cache with an optional TTL. Keys are spread over shards, each
+// a recency list plus a hash index behind its own lock, so get/put
+// are O(1) and threads touching different shards do not contend. Recency and
+// capacity are per shard (capacity / shards each), which approximates a global
+// LRU closely once the cache holds more than a handful of entries per shard.
+// A ttl of zero (the default) keeps entries until they are evicted.
+template <class K, class V, class Hash = std::hash<K>, class Eq = std::equal_to<K>>
+class lru_cache {
+public:
+  using clock = std::chrono::steady_clock;
+
+  // shards = 0: chosen from the capacity (up to 16, at least 8 entries each)
+  explicit lru_cache(std::size_t capacity, clock::duration ttl = clock::duration::zero(),
+                     std::size_t shards = 0)
+    : ttl_(ttl) {
+    if (capacity == 0) capacity = 1;
+    if (shards == 0) {
+      shards = 1;
+      while (shards < 16 && capacity / (shards * 2) >= 8) shards *= 2;
+    }
+    std::size_t n = 1;
+    while (n < shards) n <<= 1;
+    if (n > capacity) n = 1;
+    mask_ = n - 1;
+    shards_ = std::make_unique<shard[]>(n);
+    const std::size_t per = (capacity + n - 1) / n;
+    for (std::size_t i = 0; i < n; ++i) shards_[i].capacity = per;
+  }
+
+  lru_cache(const lru_cache&) = delete;
+  lru_cache& operator=(const lru_cache&) = delete;
+
+  // The cached value (and marks it most recently used), or nullopt
+  std::optional<V> get(const K& key) {
+    shard& s = shard_for(key);
+    std::unique_lock<std::mutex> lock(s.m);
+    auto it = s.index.find(key);
+    if (it == s.index.end()) {
+      lock.unlock();
+      misses_.fetch_add(1, std::memory_order_relaxed);
+      return std::nullopt;
+    }
+    if (ttl_ > clock::duration::zero() && clock::now() >= it->second->expires) {
+      s.order.erase(it->second);
+      s.index.erase(it);
+      lock.unlock();
+      expired_.fetch_add(1, std::memory_order_relaxed);
+      misses_.fetch_add(1, std::memory_order_relaxed);
+      return std::nullopt;
+    }
+    s.order.splice(s.order.begin(), s.order, it->second);
+    std::optional<V> out(it->second->value);
+    lock.unlock();
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return out;
+  }
+
+  // Inserts or replaces key; the least recently used entry of the shard makes
+  // room if it is full
+  void put(const K& key, V value) {
+    shard& s = shard_for(key);
+    const auto expires = ttl_ > clock::duration::zero() ? clock::now() + ttl_ : clock::time_point::max();
+    std::optional<node> victim; // destroyed outside the lock
+    {
+      std::lock_guard<std::mutex> lock(s.m);
+      auto it = s.index.find(key);
+      if (it != s.index.end()) {
+        it->second->value = std::move(value);
+        it->second->expires = expires;
+        s.order.splice(s.order.begin(), s.order, it->second);
+        return;
+      }
+      if (s.index.size() >= s.capacity) {
+        victim.emplace(std::move(s.order.back()));
+        s.index.erase(victim->key);
+        s.order.pop_back();
+      }
+      s.order.push_front(node{key, std::move(value), expires});
+      s.index.emplace(key, s.order.begin());
+    }
+    if (victim) evictions_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  bool erase(const K& key) {
+    shard& s = shard_for(key);
+    std::lock_guard<std::mutex> lock(s.m);
+    auto it = s.index.find(key);
+    if (it == s.index.end()) return false;
+    s.order.erase(it->second);
+    s.index.erase(it);
+    return true;
+  }
+
+  void clear() {
+    for (std::size_t i = 0; i <= mask_; ++i) {
+      std::lock_guard<std::mutex> lock(shards_[i].m);
+      shards_[i].index.clear();
+      shards_[i].order.clear();
+    }
+  }
+
+  std::size_t size() const {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i <= mask_; ++i) {
+      std::lock_guard<std::mutex> lock(shards_[i].m);
+      n += shards_[i].index.size();
+    }
+    return n;
+  }
+
+  std::size_t shard_count() const noexcept { return mask_ + 1; }
+
+  cache_stats stats() const {
+    return cache_stats{hits_.load(std::memory_order_relaxed),
+                       misses_.load(std::memory_order_relaxed),
+                       evictions_.load(std::memory_order_relaxed),
+                       expired_.load(std::memory_order_relaxed),
+                       size()};
+  }
+
+private:
+  struct node {
+    K key;
+    V value;
+    clock::time_point expires;
+  };
+
+  struct alignas(64) shard {
+    mutable std::mutex m;
+    std::size_t capacity{1};
+    std::list<node> order;  // most recently used first
+    std::unordered_map<K, typename std::list<node>::iterator, Hash, Eq> index;
+  };
+
+  shard& shard_for(const K& key) {
+    std::uint64_t h = Hash{}(key);
+    h ^= h >> 17;                     // std::hash is the identity for integers
+    h *= 0x9E3779B97F4A7C15ull;
+    return shards_[static_cast<std::size_t>(h >> 32) & mask_];
+  }
+
+  clock::duration ttl_;
+  std::size_t mask_{0};
+  std::unique_ptr<shard[]> shards_;
+  std::atomic<std::uint64_t> hits_{0};
+  std::atomic<std::uint64_t> misses_{0};
+  std::atomic<std::uint64_t> evictions_{0};
+  std::atomic<std::uint64_t> expired_{0};
+};
+
+} // namespace pulse
@@ -0,0 +1,61 @@
+#pragma once
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace pulse {
+
+// Unbounded lock-free multi-producer / single-consumer queue (Vyukov's intrusive
+// MPSC list with a stub node). push() is wait-free; try_pop() must be called from
+// one consumer at a time. A pop racing with an unfinished push may see the queue
+// as empty - callers that count items (see observe_on(ex, batched)) know a counted
+// item becomes visible right after the pushing call returns.
+template <class T>
+class mpsc_queue {
+public:
+  mpsc_queue() : head_(&stub_), tail_(&stub_) {}
+
+  mpsc_queue(const mpsc_queue&) = delete;
+  mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+  ~mpsc_queue() {
+    while (try_pop()) {}
+    if (tail_ != &stub_) delete tail_;
+  }
+
+  void push(T v) {
+    auto* n = new node(std::move(v));
+    node* prev = head_.exchange(n, std::memory_order_acq_rel);
+    prev->next.store(n, std::memory_order_release);
+  }
+
+  std::optional<T> try_pop() {
+    node* tail = tail_;
+    node* next = tail->next.load(std::memory_order_acquire);
+    if (!next) return std::nullopt;
+    tail_ = next;
+    std::optional<T> out(std::move(next->value));
+    next->value.reset(); // `next` becomes the new stub
+    if (tail != &stub_) delete tail;
+    return out;
+  }
+
+  // Only meaningful from the consumer thread
+  bool empty() const noexcept {
+    return tail_->next.load(std::memory_order_acquire) == nullptr;
+  }
+
+private:
+  struct node {
+    node() = default;
+    explicit node(T v) : value(std::move(v)) {}
+    std::atomic<node*> next{nullptr};
+    std::optional<T> value;
+  };
+
+  node stub_;
+  std::atomic<node*> head_; // producers
+  node* tail_;              // consumer
+};
+
+} // namespace pulse
@@ -0,0 +1,159 @@
+#pragma once
+#include <pulse/core/observable.hpp>
+#include <pulse/core/utility.hpp>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace pulse {
+
+// multicast_hub<T>: the subscriber list behind subject, share() and
+// connectable_observable.
+//
+// - add()/remove() take a short writer lock and are O(1): subscribers live in a
+//   slot table and freed slots are recycled, so churn does not grow the table.
+// - on_next() takes no lock and does not allocate: it walks an immutable snapshot
+//   of the live subscribers. A membership change only marks the snapshot dirty; it
+//   is rebuilt once, by the next emission.
+// - A removed subscriber is flagged dead at once, so an emission that still holds
+//   an older snapshot skips it.
+//
+// Terminal state (completed/errored) is left to the owner.
+template <class T>
+class multicast_hub {
+public:
+  using OnNext = typename observable<T>::OnNext;
+  using OnErr  = typename observable<T>::OnErr;
+  using OnDone = typename observable<T>::OnDone;
+
+  struct entry {
+    OnNext on_next;
+    OnErr  on_err;
+    OnDone on_done;
+    std::atomic<bool> alive{true};
+    std::size_t slot{0}; // guarded by the hub lock
+  };
+  using handle = std::shared_ptr<entry>;
+
+  multicast_hub() = default;
+  multicast_hub(const multicast_hub&) = delete;
+  multicast_hub& operator=(const multicast_hub&) = delete;
+
+  handle add(OnNext on_next, OnErr on_err, OnDone on_done) {
+    auto e = std::make_shared<entry>();
+    e->on_next = std::move(on_next);
+    e->on_err  = std::move(on_err);
+    e->on_done = std::move(on_done);
+
+    std::lock_guard<std::mutex> lock(m_);
+    if (!free_.empty()) {
+      e->slot = free_.back();
+      free_.pop_back();
+      slots_[e->slot] = e;
+    } else {
+      e->slot = slots_.size();
+      slots_.push_back(e);
+    }
+    ++count_;
+    dirty_.store(true, std::memory_order_release);
+    return e;
+  }
+
+  // Returns the number of subscribers left. Removing a handle that is no longer
+  // registered (already removed, or dropped by detach_all) is a no-op.
+  std::size_t remove(const handle& h) {
+    if (!h) return size();
+    h->alive.store(false, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(m_);
+    if (h->slot < slots_.size() && slots_[h->slot] == h) {
+      slots_[h->slot] = nullptr;
+      free_.push_back(h->slot);
+      --count_;
+      if (count_ == 0) {
+        // nothing left to deliver to: release the callbacks right away
+        snapshot_.store(nullptr);
+        dirty_.store(false, std::memory_order_release);
+      } else {
+        dirty_.store(true, std::memory_order_release);
+      }
+    }
+    return count_;
+  }
+
+  // Unregisters everyone and returns the handles (for terminal fan-out).
+  std::vector<handle> detach_all() {
+    std::vector<handle> out;
+    std::lock_guard<std::mutex> lock(m_);
+    out.reserve(count_);
+    for (auto& s : slots_) {
+      if (!s) continue;
+      s->alive.store(false, std::memory_order_release);
+      out.push_back(std::move(s));
+    }
+    slots_.clear();
+    free_.clear();
+    count_ = 0;
+    snapshot_.store(nullptr);
+    dirty_.store(false, std::memory_order_release);
+    return out;
+  }
+
+  void on_next(const T& v) {
+    auto snap = current();
+    if (!snap) return;
+    for (auto& e : *snap) {
+      if (e->alive.load(std::memory_order_acquire) && e->on_next) e->on_next(v);
+    }
+  }
+
+  void on_error(std::exception_ptr err) {
+    for (auto& e : detach_all()) if (e->on_err) e->on_err(err);
+  }
+
+  void on_completed() {
+    for (auto& e : detach_all()) if (e->on_done) e->on_done();
+  }
+
+  std::size_t size() const {
+    std::lock_guard<std::mutex> lock(m_);
+    return count_;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  // Size of the slot table (live + recyclable slots)
+  std::size_t capacity() const {
+    std::lock_guard<std::mutex> lock(m_);
+    return slots_.size();
+  }
+
+private:
+  using snapshot = std::vector<handle>;
+
+  std::shared_ptr<const snapshot> current() {
+    if (dirty_.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lock(m_);
+      if (dirty_.load(std::memory_order_relaxed)) {
+        auto next = std::make_shared<snapshot>();
+        next->reserve(count_);
+        for (auto& s : slots_) if (s) next->push_back(s);
+        snapshot_.store(std::move(next));
+        dirty_.store(false, std::memory_order_release);
+      }
+    }
+    return snapshot_.load();
+  }
+
+  mutable std::mutex m_;                        // writers and snapshot rebuilds
+  std::vector<handle> slots_;
+  std::vector<std::size_t> free_;
+  std::size_t count_{0};
+  std::atomic<bool> dirty_{false};
+  detail::atomic_shared<const snapshot> snapshot_;
+};
+
+} // namespace pulse
@@ -1,11 +1,15 @@
 #pragma once
 #include <functional>
+#include <memory>
+#include <type_traits>
 #include <utility>
 #include <exception>
 #include <pulse/core/subscription.hpp>
 
 namespace pulse {
 
+class demand; // see core/demand.hpp
+
 template <class T>
 class observable {
 public:
@@ -13,24 +17,49 @@ public:
   using OnNext = std::function<void(const T&)>;
   using OnErr  = std::function<void(std::exception_ptr)>;
   using OnDone = std::function<void()>;
+  using FlowImpl = std::function<subscription(OnNext, OnErr, OnDone, std::shared_ptr<demand>)>;
 
   // Factory: create observable from subscribe function
   static observable create(std::function<subscription(OnNext, OnErr, OnDone)> impl) {
-    return observable(std::move(impl));
+    return observable(std::move(impl), FlowImpl{});
+  }
+
+  // Factory for demand-aware sources and operators: impl also receives the
+  // subscriber's demand (nullptr = no flow control requested).
+  static observable create_flow(FlowImpl impl) {
+    return observable({}, std::move(impl));
   }
 
   // Subscription
   subscription subscribe(OnNext on_next,
                          OnErr  on_err  = {},
                          OnDone on_done = {}) const {
+    if (flow_) return flow_(std::move(on_next), std::move(on_err), std::move(on_done), nullptr);
+    return impl_(std::move(on_next), std::move(on_err), std::move(on_done));
+  }
+
+  // Subscription with flow control: values arrive only as requested via d->request(n).
+  // Observables built with create() ignore d and emit without limit.
+  subscription subscribe(OnNext on_next, OnErr on_err, OnDone on_done,
+                         std::shared_ptr<demand> d) const {
+    if (flow_) return flow_(std::move(on_next), std::move(on_err), std::move(on_done), std::move(d));
     return impl_(std::move(on_next), std::move(on_err), std::move(on_done));
   }
 
+  // True if subscribe(..., demand) is honored
+  bool supports_demand() const noexcept { return static_cast<bool>(flow_); }
+
 private:
-  explicit observable(std::function<subscription(OnNext, OnErr, OnDone)> impl)
-    : impl_(std::move(impl)) {}
+  observable(std::function<subscription(OnNext, OnErr, OnDone)> impl, FlowImpl flow)
+    : impl_(std::move(impl)), flow_(std::move(flow)) {}
 
   std::function<subscription(OnNext, OnErr, OnDone)> impl_;
+  FlowImpl flow_;
 };
 
+namespace detail {
+template <class> struct is_observable : std::false_type {};
+template <class T> struct is_observable<observable<T>> : std::true_type {};
+} // namespace detail
+
 } // namespace pulse
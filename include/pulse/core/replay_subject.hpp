@@ -0,0 +1,291 @@
+#pragma once
+#include <pulse/core/observable.hpp>
+#include <pulse/core/subscription.hpp>
+#include <pulse/core/multicast_hub.hpp>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace pulse {
+
+template <class T> class behavior_subject;
+
+namespace detail {
+
+// Fixed-capacity ring of the last values, preallocated up front.
+// One writer at a time (the owner serializes producers); readers copy entries out
+// without any lock shared with the writer:
+// - trivially copyable T: per-slot seqlock, a torn read is detected and dropped;
+// - other T: per-slot spin flag, held only while one value is copied.
+template <class T>
+class replay_ring {
+public:
+  using clock = std::chrono::steady_clock;
+
+  struct item {
+    T value;
+    clock::time_point ts;
+  };
+
+  explicit replay_ring(std::size_t capacity)
+    : cap_(capacity ? capacity : 1), slots_(new slot[cap_]) {}
+
+  replay_ring(const replay_ring&) = delete;
+  replay_ring& operator=(const replay_ring&) = delete;
+
+  std::size_t capacity() const noexcept { return cap_; }
+
+  // Sequence number of the next push (= number of values pushed so far)
+  std::uint64_t head() const noexcept { return head_.load(std::memory_order_acquire); }
+
+  // Writer side. Returns the sequence number assigned to v.
+  std::uint64_t push(const T& v, clock::time_point ts) {
+    const std::uint64_t seq = head_.load(std::memory_order_relaxed);
+    slots_[seq % cap_].write(seq, v, ts);
+    head_.store(seq + 1, std::memory_order_release);
+    return seq;
+  }
+
+  // Reader side: entry `seq`, or nullopt if it was already overwritten.
+  std::optional<item> read(std::uint64_t seq) const {
+    return slots_[seq % cap_].read(seq);
+  }
+
+private:
+  struct seq_slot {
+    std::atomic<std::uint64_t> ver{0}; // 2*(seq+1) when stable, odd while written
+    alignas(T) std::array<unsigned char, sizeof(T)> bytes{};
+    clock::rep ts{};
+
+    void write(std::uint64_t seq, const T& v, clock::time_point t) {
+      ver.store(2 * seq + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      std::memcpy(bytes.data(), &v, sizeof(T));
+      ts = t.time_since_epoch().count();
+      ver.store(2 * seq + 2, std::memory_order_release);
+    }
+
+    std::optional<item> read(std::uint64_t seq) const {
+      const std::uint64_t want = 2 * seq + 2;
+      if (ver.load(std::memory_order_acquire) != want) return std::nullopt;
+      std::array<unsigned char, sizeof(T)> copy;
+      std::memcpy(copy.data(), bytes.data(), sizeof(T));
+      const clock::rep t = ts;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (ver.load(std::memory_order_relaxed) != want) return std::nullopt;
+      return item{std::bit_cast<T>(copy), clock::time_point(clock::duration(t))};
+    }
+  };
+
+  struct locked_slot {
+    mutable std::atomic_flag busy = ATOMIC_FLAG_INIT;
+    std::uint64_t seq{0};
+    std::optional<item> it;
+
+    void lock() const noexcept { while (busy.test_and_set(std::memory_order_acquire)) {} }
+    void unlock() const noexcept { busy.clear(std::memory_order_release); }
+
+    void write(std::uint64_t s, const T& v, clock::time_point t) {
+      lock();
+      seq = s;
+      it.emplace(item{v, t});
+      unlock();
+    }
+
+    std::optional<item> read(std::uint64_t s) const {
+      lock();
+      std::optional<item> out;
+      if (it && seq == s) out = it;
+      unlock();
+      return out;
+    }
+  };
+
+  using slot = std::conditional_t<std::is_trivially_copyable_v<T>, seq_slot, locked_slot>;
+
+  std::size_t cap_;
+  std::unique_ptr<slot[]> slots_;
+  std::atomic<std::uint64_t> head_{0};
+};
+
+} // namespace detail
+
+// replay_subject<T>: subject that replays the last N values (or the values of the
+// last `window`) to every new subscriber, then continues with live events without
+// gaps or duplicates. After on_completed/on_error late subscribers still get the
+// replay, followed by the terminal event.
+//
+// Producers are serialized by a short lock around the ring write; a joining
+// subscriber takes it only to register, and copies the ring outside of it, so a
+// late joiner does not stall a hot producer. Live events that arrive while the
+// joiner is still replaying are buffered for that joiner only.
+template <class T>
+class replay_subject {
+public:
+  using OnNext = typename observable<T>::OnNext;
+  using OnErr  = typename observable<T>::OnErr;
+  using OnDone = typename observable<T>::OnDone;
+  using clock  = std::chrono::steady_clock;
+
+  // Keeps the last n values
+  explicit replay_subject(std::size_t n) : ring_(n) {}
+
+  // Keeps the values of the last `window`, at most `capacity` of them
+  template <class Rep, class Period>
+  explicit replay_subject(std::chrono::duration<Rep, Period> window, std::size_t capacity = 1024)
+    : ring_(capacity), window_(std::chrono::duration_cast<clock::duration>(window)) {}
+
+  replay_subject(const replay_subject&) = delete;
+  replay_subject& operator=(const replay_subject&) = delete;
+
+  observable<T> as_observable() {
+    return observable<T>::create([this](OnNext on_next, OnErr on_err, OnDone on_done) {
+      auto j = std::make_shared<joiner>();
+      j->on_next = std::move(on_next);
+      j->on_err  = std::move(on_err);
+      j->on_done = std::move(on_done);
+
+      std::uint64_t end = 0;
+      bool completed = false;
+      std::exception_ptr error;
+      typename multicast_hub<tick>::handle h;
+      {
+        std::lock_guard<std::mutex> lock(m_);
+        end = ring_.head();
+        j->from = end;
+        completed = completed_;
+        error = error_;
+        if (!completed && !error) {
+          h = hub_.add(
+            [j](const tick& t){ if (t.seq >= j->from) j->next(*t.value); },
+            [j](std::exception_ptr e){ j->push(event{std::nullopt, e, false}); },
+            [j]{ j->push(event{std::nullopt, nullptr, true}); });
+        }
+      }
+
+      // Replay without the producer lock
+      const std::uint64_t begin = end > ring_.capacity() ? end - ring_.capacity() : 0;
+      const auto now = window_ ? clock::now() : clock::time_point{};
+      for (std::uint64_t s = begin; s < end; ++s) {
+        auto it = ring_.read(s);
+        if (!it) continue; // overwritten meanwhile
+        if (window_ && now - it->ts > *window_) continue;
+        if (j->on_next) j->on_next(it->value);
+      }
+      j->go_live();
+
+      if (error)     { if (j->on_err)  j->on_err(error); return subscription{}; }
+      if (completed) { if (j->on_done) j->on_done();     return subscription{}; }
+
+      return subscription([this, h]{ hub_.remove(h); });
+    });
+  }
+
+  // push-API
+  void on_next(const T& v) { push(v, []{}); }
+
+  void on_error(std::exception_ptr e) {
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      if (completed_ || error_) return;
+      error_ = e;
+    }
+    hub_.on_error(e);
+  }
+
+  void on_completed() {
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      if (completed_ || error_) return;
+      completed_ = true;
+    }
+    hub_.on_completed();
+  }
+
+private:
+  template <class> friend class behavior_subject;
+
+  // on_next that also runs `under_lock` while producers are serialized
+  template <class F>
+  void push(const T& v, F&& under_lock) {
+    std::uint64_t seq = 0;
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      if (completed_ || error_) return;
+      under_lock();
+      seq = ring_.push(v, window_ ? clock::now() : clock::time_point{});
+    }
+    hub_.on_next(tick{seq, &v});
+  }
+
+  struct tick {
+    std::uint64_t seq;
+    const T* value;
+  };
+
+  struct event {
+    std::optional<T> value;
+    std::exception_ptr error;
+    bool done;
+  };
+
+  // One subscriber: buffers live events until its replay is finished
+  struct joiner {
+    OnNext on_next;
+    OnErr  on_err;
+    OnDone on_done;
+    std::uint64_t from{0};          // first sequence number delivered live
+    std::atomic<bool> live{false};
+    std::mutex m;
+    std::vector<event> pending;
+
+    void next(const T& v) {
+      if (live.load(std::memory_order_acquire)) { if (on_next) on_next(v); return; }
+      push(event{v, nullptr, false});
+    }
+
+    void push(event ev) {
+      if (!live.load(std::memory_order_acquire)) {
+        std::unique_lock<std::mutex> lock(m);
+        if (!live.load(std::memory_order_relaxed)) { pending.push_back(std::move(ev)); return; }
+      }
+      dispatch(ev);
+    }
+
+    void go_live() {
+      for (;;) {
+        std::vector<event> batch;
+        {
+          std::lock_guard<std::mutex> lock(m);
+          if (pending.empty()) { live.store(true, std::memory_order_release); return; }
+          batch.swap(pending);
+        }
+        for (auto& ev : batch) dispatch(ev);
+      }
+    }
+
+    void dispatch(const event& ev) {
+      if (ev.value)      { if (on_next) on_next(*ev.value); }
+      else if (ev.error) { if (on_err) on_err(ev.error); }
+      else if (ev.done)  { if (on_done) on_done(); }
+    }
+  };
+
+  std::mutex m_; // producers and terminal state
+  detail::replay_ring<T> ring_;
+  multicast_hub<tick> hub_;
+  std::optional<clock::duration> window_;
+  bool completed_{false};
+  std::exception_ptr error_{};
+};
+
+} // namespace pulse
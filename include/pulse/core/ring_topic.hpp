@@ -0,0 +1,306 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <pulse/core/backpressure.hpp>
+#include <pulse/core/cancel_group.hpp>
+#include <pulse/core/observable.hpp>
+#include <pulse/core/scheduler.hpp>
+#include <pulse/core/subscription.hpp>
+#include <pulse/core/topic.hpp>
+#include <pulse/core/utility.hpp>
+
+namespace pulse {
+
+// How a producer waits while the slowest subscriber still holds the slot it
+// needs: burn the core, yield it, or sleep until a subscriber advances.
+enum class wait_strategy { spin, yield, block };
+
+// ring_topic<T>: Disruptor-style multicast topic.
+//
+// One preallocated ring of `capacity` slots (rounded up to a power of two).
+// publish() claims a sequence, waits until every subscriber has read the slot's
+// previous value (gating), copies the value in and publishes the sequence: O(1)
+// writes per event regardless of the number of subscribers, and no allocation.
+// Each subscriber owns a cursor and reads the slots in place on its executor; a
+// drain task is posted only when the subscriber was idle, so a busy subscriber
+// takes whole runs of events per task.
+//
+// Lossless: a slow subscriber slows the producers down (see wait_strategy)
+// instead of losing events. accept()-style policies (bp_none, bp_drop, ...)
+// filter at read time; policies with publish(...) need per-subscriber queues
+// and belong on topic<T>. Don't publish from a subscriber of the same ring and
+// don't let a full ring wait on an executor that only the producer drives.
+// T must be default-constructible and copy-assignable.
+template <class T>
+class ring_topic {
+  static_assert(std::is_default_constructible_v<T> && std::is_copy_assignable_v<T>,
+                "ring_topic<T> preallocates T slots");
+
+public:
+  explicit ring_topic(std::size_t capacity = 1024, wait_strategy ws = wait_strategy::yield)
+    : core_(std::make_shared<core>(capacity, ws)) {}
+  ring_topic(const ring_topic&) = delete;
+  ring_topic& operator=(const ring_topic&) = delete;
+
+  ~ring_topic() { core_->close_all(); }
+
+  template <class Fn, class BP = bp_none>
+  subscription subscribe(executor& exec, priority prio, BP bp, Fn&& fn) {
+    static_assert(!detail::has_bp_publish<BP, T, executor, std::function<void(const T&)>>,
+                  "ring_topic filters with accept()-style policies only");
+    using FnT = std::decay_t<Fn>;
+
+    auto c = std::make_shared<consumer>();
+    c->exec = &exec;
+    c->prio = prio.value;
+    c->fn = [f = FnT(std::forward<Fn>(fn))](const T& v) { f(v); };
+    if constexpr (!std::is_same_v<BP, bp_none>)
+      c->accept = [bp = std::move(bp)]() mutable { return bp.accept(); };
+    c->group = std::make_shared<cancel_group>();
+
+    core_->add(c);
+    return subscription([w = std::weak_ptr<core>(core_), c] {
+      c->closed.store(true, std::memory_order_seq_cst);
+      c->group->cancel();
+      // A drain still reading a slot keeps gating it and retires the
+      // subscriber on its way out
+      if (c->draining.load(std::memory_order_seq_cst)) return;
+      if (auto k = w.lock()) k->retire(c);
+    });
+  }
+
+  // Publish an event (any thread; producers may run concurrently)
+  void publish(const T& value) { core_->publish(value); }
+
+  std::size_t capacity() const noexcept { return core_->cap; }
+  std::size_t subscribers() const { return core_->subscribers(); }
+  // True once a subscriber found its next slot overwritten and was closed
+  // (a gating bug; never expected)
+  bool lapped() const noexcept { return core_->lapped_subscriber(); }
+
+private:
+  struct consumer {
+    alignas(64) std::atomic<std::int64_t> cursor{0}; // next sequence to read
+    std::atomic<bool> scheduled{false};
+    std::atomic<bool> closed{false};
+    std::atomic<bool> draining{false};               // a drain task is running
+    std::atomic<bool> retired{false};                // removed from the list (once)
+    executor* exec{};
+    int prio{};
+    std::function<void(const T&)> fn;
+    std::function<bool()> accept;                    // empty: deliver everything
+    std::shared_ptr<cancel_group> group;
+  };
+
+  using consumer_list = std::vector<std::shared_ptr<consumer>>;
+
+  // Shared with the drain tasks, which may outlive the topic object
+  struct core : std::enable_shared_from_this<core> {
+    core(std::size_t capacity, wait_strategy w)
+      : cap(round_up(capacity)), mask(static_cast<std::int64_t>(cap) - 1), ws(w),
+        slots(new T[cap]), published(new std::atomic<std::int64_t>[cap]) {
+      for (std::size_t i = 0; i < cap; ++i)
+        published[i].store(-1, std::memory_order_relaxed);
+      consumers.store(std::make_shared<const consumer_list>());
+    }
+
+    static std::size_t round_up(std::size_t n) {
+      std::size_t p = 1;
+      while (p < n) p <<= 1;
+      return p;
+    }
+
+    void add(const std::shared_ptr<consumer>& c) {
+      {
+        std::lock_guard<std::mutex> lock(m);
+        // No drain until the start below is final
+        c->scheduled.store(true, std::memory_order_relaxed);
+        // Provisional start: producers that see the subscriber before the
+        // final start below gate on this (lower) cursor
+        c->cursor.store(claim.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+        auto next = std::make_shared<consumer_list>(*consumers.load());
+        auto it = next->begin();
+        while (it != next->end() && (*it)->prio >= c->prio) ++it; // priority desc, FIFO
+        next->insert(it, c);
+        consumers.store(std::move(next));
+        // Pairs with the fence in wait_for_slot(): a producer whose scan missed
+        // this subscriber claimed its sequence before the load below, so the
+        // gate it stores is at most `start`
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t start = claim.load(std::memory_order_seq_cst);
+        c->cursor.store(start, std::memory_order_seq_cst);
+      }
+      // Same hand-off as the end of drain(): pick up what was published meanwhile
+      c->scheduled.store(false, std::memory_order_seq_cst);
+      const std::int64_t cur = c->cursor.load(std::memory_order_relaxed);
+      if (published[static_cast<std::size_t>(cur & mask)].load(std::memory_order_seq_cst) < cur) return;
+      bool expected = false;
+      if (c->scheduled.compare_exchange_strong(expected, true, std::memory_order_seq_cst))
+        post_drain(c);
+    }
+
+    void remove(const std::shared_ptr<consumer>& c) {
+      std::lock_guard<std::mutex> lock(m);
+      auto next = std::make_shared<consumer_list>(*consumers.load());
+      std::erase(*next, c);
+      consumers.store(std::move(next));
+      wake_producers(); // it no longer gates anyone
+    }
+
+    // Removes a closed subscriber once nothing reads its slots any more
+    void retire(const std::shared_ptr<consumer>& c) {
+      if (!c->retired.exchange(true, std::memory_order_acq_rel)) remove(c);
+    }
+
+    void close_all() {
+      std::lock_guard<std::mutex> lock(m);
+      for (auto& c : *consumers.load()) {
+        c->closed.store(true, std::memory_order_release);
+        c->group->cancel();
+      }
+      consumers.store(std::make_shared<const consumer_list>());
+    }
+
+    std::size_t subscribers() const { return consumers.load()->size(); }
+    bool lapped_subscriber() const { return lapped.load(std::memory_order_relaxed); }
+
+    void publish(const T& v) {
+      const std::int64_t seq = claim.fetch_add(1, std::memory_order_seq_cst);
+      wait_for_slot(seq);
+      const std::size_t i = static_cast<std::size_t>(seq & mask);
+      slots[i] = v;
+      published[i].store(seq, std::memory_order_seq_cst);
+
+      // Wake idle subscribers; busy ones pick the event up in their current run
+      const auto subs = consumers.load();
+      for (auto& c : *subs) {
+        if (c->scheduled.load(std::memory_order_seq_cst)) continue;
+        bool expected = false;
+        if (c->scheduled.compare_exchange_strong(expected, true, std::memory_order_seq_cst))
+          post_drain(c);
+      }
+    }
+
+    // Gating: slot of `seq` still holds seq - cap until every cursor passed it.
+    // Lock-free: `gate` caches a lower bound of every cursor, present and
+    // future. A scan yields at most this producer's own sequence, which is
+    // below the start of any subscriber the scan missed (see add()), and
+    // cursors only grow, so even a stale store keeps the bound.
+    void wait_for_slot(std::int64_t seq) {
+      const std::int64_t wrap = seq - static_cast<std::int64_t>(cap);
+      if (wrap < gate.load(std::memory_order_seq_cst)) return; // cached minimum
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      for (;;) {
+        std::int64_t lowest = seq;
+        const auto subs = consumers.load(); // keeps the list alive for the scan
+        for (auto& c : *subs)
+          lowest = std::min(lowest, c->cursor.load(std::memory_order_seq_cst));
+        gate.store(lowest, std::memory_order_seq_cst);
+        if (wrap < lowest) return;
+
+        switch (ws) {
+          case wait_strategy::spin:  break;
+          case wait_strategy::yield: std::this_thread::yield(); break;
+          case wait_strategy::block: {
+            std::unique_lock<std::mutex> lock(wait_m);
+            waiting.fetch_add(1, std::memory_order_seq_cst);
+            // re-checked every millisecond as a guard against a missed wake-up
+            wait_cv.wait_for(lock, std::chrono::milliseconds(1));
+            waiting.fetch_sub(1, std::memory_order_seq_cst);
+            break;
+          }
+        }
+      }
+    }
+
+    void wake_producers() {
+      if (ws == wait_strategy::block && waiting.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock(wait_m);
+        wait_cv.notify_all();
+      }
+    }
+
+    void post_drain(const std::shared_ptr<consumer>& c) {
+      c->exec->post([self = this->shared_from_this(), c] { self->drain(c); }, c->group);
+    }
+
+    void drain(const std::shared_ptr<consumer>& c) {
+      c->draining.store(true, std::memory_order_seq_cst);
+      read(*c);
+      c->draining.store(false, std::memory_order_seq_cst);
+      // The unsubscribe either saw this drain running and left the removal to
+      // it, or it was not running yet and read() returned on `closed`
+      if (c->closed.load(std::memory_order_seq_cst)) retire(c);
+    }
+
+    // Runs on the subscriber's executor: reads every published slot in place
+    void read(consumer& c) {
+      std::int64_t cur = c.cursor.load(std::memory_order_relaxed);
+      for (;;) {
+        for (;;) {
+          if (c.closed.load(std::memory_order_seq_cst)) return;
+          const std::size_t i = static_cast<std::size_t>(cur & mask);
+          const std::int64_t p = published[i].load(std::memory_order_acquire);
+          if (p < cur) break;              // not published yet
+          // Gating keeps a slot from being reused before every cursor passed it.
+          // A newer sequence means events were lost and the slot may be in the
+          // middle of a write: never skip silently, close the subscriber instead
+          if (p != cur) {
+            lapped.store(true, std::memory_order_relaxed);
+            c.closed.store(true, std::memory_order_seq_cst);
+            c.group->cancel();
+            return;
+          }
+          if (!c.accept || c.accept()) c.fn(slots[i]);
+          c.cursor.store(++cur, std::memory_order_release);
+          wake_producers();
+        }
+        c.scheduled.store(false, std::memory_order_seq_cst);
+        const std::size_t i = static_cast<std::size_t>(cur & mask);
+        if (published[i].load(std::memory_order_seq_cst) < cur) return;
+        bool expected = false;
+        if (!c.scheduled.compare_exchange_strong(expected, true, std::memory_order_seq_cst))
+          return; // a producer re-posted us
+      }
+    }
+
+    const std::size_t cap;
+    const std::int64_t mask;
+    const wait_strategy ws;
+    std::unique_ptr<T[]> slots;
+    std::unique_ptr<std::atomic<std::int64_t>[]> published; // sequence held by each slot
+    alignas(64) std::atomic<std::int64_t> claim{0};         // next sequence to claim
+    alignas(64) std::atomic<std::int64_t> gate{0};          // lower bound of all cursors
+    detail::atomic_shared<const consumer_list> consumers;
+    std::mutex m;                                            // subscribe/unsubscribe
+    std::atomic<bool> lapped{false};                         // a subscriber was closed by a gating bug
+
+    std::mutex wait_m;                                       // wait_strategy::block
+    std::condition_variable wait_cv;
+    std::atomic<int> waiting{0};
+  };
+
+  std::shared_ptr<core> core_;
+};
+
+// Consume a ring_topic as an observable on the given executor
+template <class T>
+inline observable<T> as_observable(ring_topic<T>& t, executor& ex) {
+  return observable<T>::create([&t, &ex](auto on_next, auto, auto) {
+    return t.subscribe(ex, priority{0}, bp_none{}, [on_next](const T& v) { on_next(v); });
+  });
+}
+
+} // namespace pulse
@@ -1,7 +1,14 @@
 #pragma once
 #include <functional>
+#include <memory>
 #include <queue>
 #include <mutex>
+#include <atomic>
+#include <thread>
+#include <optional>
+#include <cstddef>
+#include <pulse/core/cancel_group.hpp>
+#include <pulse/core/mpsc_queue.hpp>
 
 namespace pulse {
 
@@ -9,22 +16,117 @@ namespace pulse {
 struct executor {
   virtual ~executor() = default;
   virtual void post(std::function<void()> f) = 0;
+
+  // Post a task on behalf of a cancel_group: once the group is cancelled the task
+  // must not run. Executors with their own queue override this to unlink pending
+  // tasks on cancel; the default only skips them when they come up.
+  // NOTE: derived executors should add `using executor::post;` to keep this overload visible.
+  virtual void post(std::function<void()> f, std::shared_ptr<cancel_group> g) {
+    if (!g) { post(std::move(f)); return; }
+    if (g->cancelled()) return;
+    post([f = std::move(f), g = std::move(g)]{
+      if (!g->cancelled()) f();
+    });
+  }
+
+  // True if a task posted now could run on the calling thread right away,
+  // i.e. the caller is already inside this executor. Must be cheap: it is
+  // checked per event by observe_on(ex, inline_if_current) and topic.
+  virtual bool running_in_this_thread() const noexcept { return false; }
+};
+
+// Opt-in tag: deliver directly instead of posting when the caller is already
+// running on the target executor (see observe_on, topic::subscribe).
+struct inline_if_current_t { explicit inline_if_current_t() = default; };
+inline constexpr inline_if_current_t inline_if_current{};
+
+namespace detail {
+
+// Delivery slot of one inline_if_current subscriber. run() delivers directly
+// when the caller is on ex and takes the free slot (0 -> 1); otherwise the
+// delivery is queued. Whoever holds the slot - an inline caller or the one
+// drain task - runs everything queued behind it before giving the slot back,
+// so deliveries never overlap and keep their order, whichever threads emit.
+class inline_serializer : public std::enable_shared_from_this<inline_serializer> {
+public:
+  template <class F>
+  void run(executor& ex, F f, const std::shared_ptr<cancel_group>& g) {
+    std::size_t free_slot = 0;
+    if (ex.running_in_this_thread() &&
+        busy_.compare_exchange_strong(free_slot, 1, std::memory_order_acq_rel)) {
+      {
+        slot_guard guard{this, ex, g};
+        f();
+        guard.armed = false;
+      }
+      release(ex, g);
+      return;
+    }
+    pending_.push(std::function<void()>(std::move(f)));
+    if (busy_.fetch_add(1, std::memory_order_acq_rel) != 0) return; // the holder runs it
+    post_drain(ex, g);
+  }
+
+private:
+  // Gives the slot up if a delivery throws: what is queued behind it goes to
+  // a drain task instead of running during unwinding
+  struct slot_guard {
+    inline_serializer* self;
+    executor& ex;
+    const std::shared_ptr<cancel_group>& g;
+    bool armed = true;
+    ~slot_guard() {
+      if (armed && self->busy_.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        self->post_drain(ex, g);
+    }
+  };
+
+  // The drain task holds the slot for the first queued delivery
+  void post_drain(executor& ex, const std::shared_ptr<cancel_group>& g) {
+    ex.post([self = shared_from_this(), &ex, g]{ self->release(ex, g, true); }, g);
+  }
+
+  // Hands the slot back, first running what was queued meanwhile (`first`:
+  // the slot was taken for a queued delivery, which has not run yet)
+  void release(executor& ex, const std::shared_ptr<cancel_group>& g, bool first = false) {
+    if (!first && busy_.fetch_sub(1, std::memory_order_acq_rel) == 1) return;
+    for (;;) {
+      std::optional<std::function<void()>> f;
+      // A counted push may still be linking its node: let its thread run
+      while (!(f = pending_.try_pop())) std::this_thread::yield();
+      if (!g || !g->cancelled()) {
+        slot_guard guard{this, ex, g};
+        (*f)();
+        guard.armed = false;
+      }
+      if (busy_.fetch_sub(1, std::memory_order_acq_rel) == 1) return;
+    }
+  }
+
+  std::atomic<std::size_t> busy_{0};     // holder + queued deliveries
+  mpsc_queue<std::function<void()>> pending_;
 };
 
+} // namespace detail
+
 // Synchronous: executes immediately (good for MVP/tests)
 struct inline_executor final : executor {
+  using executor::post;
   void post(std::function<void()> f) override { f(); }
+  bool running_in_this_thread() const noexcept override { return true; }
 };
 
 // Sequential queue (no separate thread, executed by drain())
 class strand final : public executor {
 public:
+  using executor::post;
   void post(std::function<void()> f) override {
     std::lock_guard<std::mutex> lock(m_);
     q_.push(std::move(f));
   }
   // Explicit task drainage (call from the required thread, for example, the UI thread)
   void drain() {
+    const auto prev = drainer_.exchange(std::this_thread::get_id(), std::memory_order_acq_rel);
     for (;;) {
       std::function<void()> f;
       {
@@ -34,8 +136,15 @@ public:
       }
       f();
     }
+    drainer_.store(prev, std::memory_order_release);
+  }
+
+  // True while drain() runs on the calling thread
+  bool running_in_this_thread() const noexcept override {
+    return drainer_.load(std::memory_order_acquire) == std::this_thread::get_id();
   }
 private:
+  std::atomic<std::thread::id> drainer_{};
   std::mutex m_;
   std::queue<std::function<void()>> q_;
 };
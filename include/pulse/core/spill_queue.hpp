@@ -0,0 +1,271 @@
+#pragma once
+#include <pulse/core/bp_stats.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define PULSE_HAS_SPILL 1
+#else
+#define PULSE_HAS_SPILL 0
+#endif
+
+// Disk-backed overflow for lossless buffering (POSIX only, opt-in header):
+// - spill_queue<T, Codec>: FIFO of encoded values in append-only, memory-mapped
+//   segment files; drained segments are deleted.
+// - bp_spill<T, Codec>: topic policy with a bounded in-memory queue that spills
+//   to a spill_queue instead of dropping.
+
+#if PULSE_HAS_SPILL
+namespace pulse {
+
+// Codec: encode(v, out) appends the bytes of v to out; decode(bytes) rebuilds it.
+// trivial_codec copies the object representation (trivially copyable T only).
+template <class T>
+struct trivial_codec {
+  static_assert(std::is_trivially_copyable_v<T>, "trivial_codec needs a trivially copyable T");
+  void encode(const T& v, std::string& out) const {
+    out.append(reinterpret_cast<const char*>(&v), sizeof(T));
+  }
+  T decode(std::string_view bytes) const {
+    T v;
+    std::memcpy(&v, bytes.data(), sizeof(T));
+    return v;
+  }
+};
+
+namespace detail {
+
+// One append-only segment file, mapped for its whole size
+class spill_segment {
+public:
+  spill_segment(std::filesystem::path path, std::size_t size) : path_(std::move(path)), size_(size) {
+    fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd_ < 0) throw std::system_error(errno, std::generic_category(), "spill: open " + path_.string());
+    if (::ftruncate(fd_, static_cast<off_t>(size_)) != 0) {
+      const int e = errno;
+      cleanup();
+      throw std::system_error(e, std::generic_category(), "spill: ftruncate " + path_.string());
+    }
+    void* p = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (p == MAP_FAILED) {
+      const int e = errno;
+      cleanup();
+      throw std::system_error(e, std::generic_category(), "spill: mmap " + path_.string());
+    }
+    base_ = static_cast<char*>(p);
+  }
+
+  spill_segment(const spill_segment&) = delete;
+  spill_segment& operator=(const spill_segment&) = delete;
+  ~spill_segment() { cleanup(); }
+
+  // Appends one length-prefixed record; false if it does not fit
+  bool append(std::string_view rec) {
+    const std::uint32_t len = static_cast<std::uint32_t>(rec.size());
+    if (size_ - write_ < sizeof(len) + rec.size()) return false;
+    std::memcpy(base_ + write_, &len, sizeof(len));
+    std::memcpy(base_ + write_ + sizeof(len), rec.data(), rec.size());
+    write_ += sizeof(len) + rec.size();
+    return true;
+  }
+
+  // Next record, valid until the segment is destroyed
+  std::optional<std::string_view> next() {
+    if (read_ == write_) return std::nullopt;
+    std::uint32_t len;
+    std::memcpy(&len, base_ + read_, sizeof(len));
+    std::string_view rec(base_ + read_ + sizeof(len), len);
+    read_ += sizeof(len) + len;
+    return rec;
+  }
+
+  const std::filesystem::path& path() const noexcept { return path_; }
+
+private:
+  void cleanup() noexcept {
+    if (base_) ::munmap(base_, size_);
+    if (fd_ >= 0) ::close(fd_);
+    std::error_code ec;
+    std::filesystem::remove(path_, ec);
+    base_ = nullptr;
+    fd_ = -1;
+  }
+
+  std::filesystem::path path_;
+  std::size_t size_;
+  int fd_{-1};
+  char* base_{nullptr};
+  std::size_t write_{0};
+  std::size_t read_{0};
+};
+
+} // namespace detail
+
+// FIFO of values spilled to `dir`. Not thread-safe: the owner serializes access.
+// Files are named pulse-spill-<pid>-<queue>-<segment>.seg and removed once read
+// (or when the queue is destroyed).
+template <class T, class Codec = trivial_codec<T>>
+class spill_queue {
+public:
+  explicit spill_queue(std::filesystem::path dir,
+                       std::size_t segment_bytes = std::size_t{64} << 20,
+                       Codec codec = {})
+    : dir_(std::move(dir)), segment_bytes_(segment_bytes ? segment_bytes : 4096),
+      codec_(std::move(codec)), id_(next_id()) {}
+
+  spill_queue(const spill_queue&) = delete;
+  spill_queue& operator=(const spill_queue&) = delete;
+
+  void push(const T& v) {
+    scratch_.clear();
+    codec_.encode(v, scratch_);
+    if (segs_.empty() || !segs_.back()->append(scratch_)) {
+      const std::size_t need = scratch_.size() + sizeof(std::uint32_t);
+      segs_.push_back(std::make_unique<detail::spill_segment>(
+        dir_ / ("pulse-spill-" + std::to_string(::getpid()) + "-" + std::to_string(id_) +
+                "-" + std::to_string(seg_no_++) + ".seg"),
+        need > segment_bytes_ ? need : segment_bytes_));
+      segs_.back()->append(scratch_);
+    }
+    ++size_;
+  }
+
+  std::optional<T> pop() {
+    while (!segs_.empty()) {
+      if (auto rec = segs_.front()->next()) {
+        --size_;
+        return codec_.decode(*rec);
+      }
+      if (segs_.size() == 1) break; // the segment being written: keep it
+      segs_.pop_front();            // drained: unmapped and deleted
+    }
+    if (size_ == 0) segs_.clear();
+    return std::nullopt;
+  }
+
+  bool empty() const noexcept { return size_ == 0; }
+  std::size_t size() const noexcept { return size_; }
+  std::size_t segments() const noexcept { return segs_.size(); }
+
+private:
+  static std::uint64_t next_id() {
+    static std::atomic<std::uint64_t> ids{0};
+    return ids.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  std::filesystem::path dir_;
+  std::size_t segment_bytes_;
+  Codec codec_;
+  std::uint64_t id_;
+  std::uint64_t seg_no_{0};
+  std::deque<std::unique_ptr<detail::spill_segment>> segs_;
+  std::size_t size_{0};
+  std::string scratch_;
+};
+
+// ── "Buffer, then spill to disk" ────────────────────────────────────────────────
+// Lossless: up to `memory_capacity` events wait in RAM, the overflow is appended
+// to segment files in `dir` and read back in order once the consumer catches up.
+// While anything is on disk new events go to disk too, so the order is kept.
+// Disk I/O happens under the policy's lock (appends and reads are memcpy into
+// mapped pages; the kernel writes them back). If a segment cannot be created
+// (disk full, missing directory) the event is counted as dropped instead of
+// failing publish() for every other subscriber.
+template <class T, class Codec = trivial_codec<T>>
+class bp_spill {
+public:
+  explicit bp_spill(std::filesystem::path dir, std::size_t memory_capacity = 1024,
+                    std::size_t segment_bytes = std::size_t{64} << 20, Codec codec = {})
+    : dir_(std::move(dir)), cap_(memory_capacity ? memory_capacity : 1),
+      segment_bytes_(segment_bytes), codec_(std::move(codec)) {}
+  bp_spill(const bp_spill& o) : bp_spill(o.dir_, o.cap_, o.segment_bytes_, o.codec_) {}
+
+  template <class Executor, class Invoke>
+  void publish(const T& v, Executor& ex, Invoke invoke) {
+    bool should_schedule = false;
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      if (q_.size() < cap_ && (!disk_ || disk_->empty())) {
+        q_.push_back(v);
+      } else {
+        try {
+          if (!disk_) disk_ = std::make_unique<spill_queue<T, Codec>>(dir_, segment_bytes_, codec_);
+          disk_->push(v);
+        } catch (const std::system_error&) {
+          stats_.dropped();
+          return;
+        }
+        ++spilled_;
+      }
+      stats_.accepted();
+      stats_.depth(depth());
+      if (!scheduled_) { scheduled_ = true; should_schedule = true; }
+    }
+
+    if (should_schedule) {
+      ex.post([this, inv = std::move(invoke)]() mutable {
+        for (;;) {
+          std::optional<T> item;
+          {
+            std::lock_guard<std::mutex> lock(m_);
+            if (!q_.empty()) {
+              item.emplace(std::move(q_.front()));
+              q_.pop_front();
+            } else if (disk_) {
+              item = disk_->pop();
+            }
+            if (!item) { scheduled_ = false; break; }
+            stats_.depth(depth());
+          }
+          inv(*item);
+        }
+      });
+    }
+  }
+
+  // Events written to disk so far
+  std::uint64_t spilled() const {
+    std::lock_guard<std::mutex> lock(m_);
+    return spilled_;
+  }
+
+  // Events currently on disk
+  std::size_t on_disk() const {
+    std::lock_guard<std::mutex> lock(m_);
+    return disk_ ? disk_->size() : 0;
+  }
+
+  bp_stats stats() const noexcept { return stats_.snapshot(); }
+
+private:
+  std::size_t depth() const { return q_.size() + (disk_ ? disk_->size() : 0); }
+
+  std::filesystem::path dir_;
+  std::size_t cap_;
+  std::size_t segment_bytes_;
+  Codec codec_;
+  mutable std::mutex m_;
+  std::deque<T> q_;
+  std::unique_ptr<spill_queue<T, Codec>> disk_; // created on the first overflow
+  std::uint64_t spilled_{0};
+  bool scheduled_{false};
+  [[no_unique_address]] detail::bp_counters stats_;
+};
+
+} // namespace pulse
+#endif // PULSE_HAS_SPILL
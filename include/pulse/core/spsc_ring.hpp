@@ -0,0 +1,79 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace pulse {
+
+// Bounded lock-free single-producer / single-consumer ring. try_push() must be
+// called from one producer at a time and front()/pop() from one consumer at a
+// time (either side may move between threads as long as its calls are
+// serialized). Capacity is rounded up to a power of two.
+template <class T>
+class spsc_ring {
+public:
+  explicit spsc_ring(std::size_t capacity)
+    : cap_(round_up(capacity)), mask_(cap_ - 1), slots_(new std::optional<T>[cap_]) {}
+
+  spsc_ring(const spsc_ring&) = delete;
+  spsc_ring& operator=(const spsc_ring&) = delete;
+
+  // False if the ring is full
+  bool try_push(T v) {
+    const std::size_t t = tail_.load(std::memory_order_relaxed);
+    if (t - head_cache_ == cap_) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (t - head_cache_ == cap_) return false;
+    }
+    slots_[t & mask_].emplace(std::move(v));
+    tail_.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side: oldest value or nullptr
+  T* front() {
+    const std::size_t h = head_.load(std::memory_order_relaxed);
+    if (h == tail_cache_) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (h == tail_cache_) return nullptr;
+    }
+    return &*slots_[h & mask_];
+  }
+
+  // Consumer side: drops the value returned by front()
+  void pop() {
+    const std::size_t h = head_.load(std::memory_order_relaxed);
+    slots_[h & mask_].reset();
+    head_.store(h + 1, std::memory_order_release);
+  }
+
+  // Exact only from the consumer thread
+  bool empty() const noexcept {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+  }
+
+  std::size_t size() const noexcept {
+    return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+  }
+
+  std::size_t capacity() const noexcept { return cap_; }
+
+private:
+  static std::size_t round_up(std::size_t n) {
+    std::size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+  }
+
+  const std::size_t cap_;
+  const std::size_t mask_;
+  std::unique_ptr<std::optional<T>[]> slots_;
+  alignas(64) std::atomic<std::size_t> head_{0}; // consumer
+  std::size_t tail_cache_{0};                    // consumer's view of tail_
+  alignas(64) std::atomic<std::size_t> tail_{0}; // producer
+  std::size_t head_cache_{0};                    // producer's view of head_
+};
+
+} // namespace pulse
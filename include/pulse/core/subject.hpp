@@ -1,16 +1,25 @@
 #pragma once
 #include <pulse/core/observable.hpp>
 #include <pulse/core/subscription.hpp>
+#include <pulse/core/multicast_hub.hpp>
+#include <pulse/core/demand.hpp>
+#include <algorithm>
+#include <atomic>
 #include <mutex>
-#include <vector>
 #include <memory>
 #include <optional>
 #include <stdexcept>
+#include <vector>
 
 namespace pulse {
 
 // Subject<T>: hot source + observable<T>
 // Thread-safe. Events are fan-out to all current subscribers.
+// on_next() is lock-free and allocation-free (see multicast_hub).
+// Subscribers with flow control (subscribe(..., demand)) get their own credit gate:
+// values beyond their credit are buffered for them, up to flow_options::capacity
+// (then flow_options::overflow applies); a producer that must not lose values
+// checks demand() before emitting.
 template <class T>
 class subject {
 public:
@@ -19,79 +28,86 @@ public:
   using OnDone = typename observable<T>::OnDone;
 
   subject() = default;
+  explicit subject(flow_options opts) : flow_(opts) {}
 
   // as observable: subscription
   observable<T> as_observable() {
-    return observable<T>::create([this](OnNext on_next, OnErr on_err, OnDone on_done) {
-      std::size_t idx = 0;
+    return observable<T>::create_flow([this](OnNext on_next, OnErr on_err, OnDone on_done,
+                                             std::shared_ptr<pulse::demand> d) {
+      typename multicast_hub<T>::handle h;
+      std::shared_ptr<gate> g;
       {
         std::lock_guard<std::mutex> lock(m_);
         // If it's already completed/error-free, we'll notify the subscriber immediately
         if (completed_) { if (on_done) on_done(); return subscription{}; }
         if (error_)     { if (on_err)  on_err(*error_); return subscription{}; }
 
-        idx = next_id_++;
-        slots_.push_back({idx, std::move(on_next), std::move(on_err), std::move(on_done)});
+        if (!d) {
+          h = hub_.add(std::move(on_next), std::move(on_err), std::move(on_done));
+        } else {
+          g = std::make_shared<gate>(std::move(on_next), std::move(on_err), std::move(on_done), d, flow_);
+          h = hub_.add([g](const T& v){ g->push_next(v); },
+                       [g](std::exception_ptr e){ g->push_error(e); },
+                       [g]{ g->push_done(); });
+          gates_.push_back(g);
+        }
       }
+      if (g) g->open();
 
-      return subscription([this, idx]{
+      return subscription([this, h, g]{
+        hub_.remove(h);
+        if (!g) return;
+        g->close();
         std::lock_guard<std::mutex> lock(m_);
-        for (auto it = slots_.begin(); it != slots_.end(); ++it) {
-          if (it->id == idx) { slots_.erase(it); break; }
-        }
+        std::erase(gates_, g);
       });
     });
   }
 
+  // How many more values every flow-controlled subscriber can take right now
+  // (demand::unbounded if there are none). Producers that must not outrun slow
+  // consumers emit only while this is non-zero.
+  std::size_t demand() const {
+    std::lock_guard<std::mutex> lock(m_);
+    std::size_t out = pulse::demand::unbounded;
+    for (auto& g : gates_) out = std::min(out, g->available());
+    return out;
+  }
+
   // push-API
   void on_next(const T& v) {
-    std::vector<OnNext> local;
-    {
-      std::lock_guard<std::mutex> lock(m_);
-      if (completed_ || error_) return;
-      local.reserve(slots_.size());
-      for (auto& s : slots_) local.push_back(s.on_next);
-    }
-    for (auto& f : local) if (f) f(v);
+    if (done_.load(std::memory_order_acquire)) return;
+    hub_.on_next(v);
   }
 
   void on_error(std::exception_ptr e) {
-    std::vector<OnErr> local;
     {
       std::lock_guard<std::mutex> lock(m_);
       if (completed_ || error_) return;
       error_ = e;
-      local.reserve(slots_.size());
-      for (auto& s : slots_) local.push_back(s.on_err);
-      slots_.clear();
+      done_.store(true, std::memory_order_release);
     }
-    for (auto& f : local) if (f) f(e);
+    hub_.on_error(e);
   }
 
   void on_completed() {
-    std::vector<OnDone> local;
     {
       std::lock_guard<std::mutex> lock(m_);
       if (completed_ || error_) return;
       completed_ = true;
-      local.reserve(slots_.size());
-      for (auto& s : slots_) local.push_back(s.on_done);
-      slots_.clear();
+      done_.store(true, std::memory_order_release);
     }
-    for (auto& f : local) if (f) f();
+    hub_.on_completed();
   }
 
 private:
-  struct slot {
-    std::size_t id;
-    OnNext on_next;
-    OnErr  on_err;
-    OnDone on_done;
-  };
+  using gate = detail::flow_gate<T>;
 
-  std::mutex m_;
-  std::vector<slot> slots_;
-  std::size_t next_id_{0};
+  mutable std::mutex m_; // terminal state, flow gates
+  const flow_options flow_{};
+  multicast_hub<T> hub_;
+  std::vector<std::shared_ptr<gate>> gates_;
+  std::atomic<bool> done_{false};
   bool completed_{false};
   std::optional<std::exception_ptr> error_;
 };
@@ -1,64 +1,328 @@
 #pragma once
 #include <pulse/core/scheduler.hpp>
+#include <pulse/core/cpu_topology.hpp>
+#include <algorithm>
 #include <condition_variable>
-#include <queue>
 #include <thread>
 #include <vector>
+#include <memory>
 #include <mutex>
 #include <functional>
 #include <atomic>
 
 namespace pulse {
 
+// Construction options for thread_pool.
+// - cpus:        CPU set the workers may run on (empty = do not pin).
+// - pin_per_cpu: pin every worker to a single CPU of the set (round-robin)
+//                instead of letting it float over the whole set / node.
+// - numa_aware:  group workers by NUMA node, one task queue per node; workers
+//                are pinned to their node and steal from other nodes only when idle.
+//                Nodes beyond the thread count get no queue of their own: their
+//                CPUs post to the queue of node (i % threads).
+// - topology:    layout used by numa_aware (no nodes = cpu_topology::detect()).
+// - prefer_caller_node: post() goes to the queue of the node the caller runs on
+//                (worker threads always post to their own node).
+struct thread_pool_options {
+  std::size_t threads = std::thread::hardware_concurrency();
+  std::vector<int> cpus{};
+  bool pin_per_cpu = false;
+  bool numa_aware = false;
+  bool prefer_caller_node = true;
+  cpu_topology topology{};
+};
+
 class thread_pool final : public executor {
 public:
   explicit thread_pool(std::size_t threads = std::thread::hardware_concurrency())
-  : stop_(false) {
-    if (threads == 0) threads = 1;
-    workers_.reserve(threads);
-    for (std::size_t i = 0; i < threads; ++i) {
-      workers_.emplace_back([this]{
-        for (;;) {
-          std::function<void()> task;
-          {
-            std::unique_lock<std::mutex> lock(m_);
-            cv_.wait(lock, [&]{ return stop_ || !q_.empty(); });
-            if (stop_ && q_.empty()) return;
-            task = std::move(q_.front());
-            q_.pop();
-          }
-          task();
+  : thread_pool(thread_pool_options{threads}) {}
+
+  explicit thread_pool(thread_pool_options opts)
+  : prefer_caller_node_(opts.prefer_caller_node) {
+    if (opts.threads == 0) opts.threads = 1;
+
+    // Which CPUs belong to which queue
+    std::vector<std::vector<int>> groups;
+    if (opts.numa_aware) {
+      auto topo = opts.topology.nodes.empty() ? cpu_topology::detect() : std::move(opts.topology);
+      if (!opts.cpus.empty()) topo = topo.restricted_to(opts.cpus);
+      groups = std::move(topo.nodes);
+      // A queue without workers would only be drained by stealing
+      const std::size_t used = std::min(groups.size(), opts.threads);
+      for (std::size_t ni = 0; ni < groups.size(); ++ni) {
+        for (int c : groups[ni]) {
+          const auto idx = static_cast<std::size_t>(c);
+          if (idx >= cpu_to_queue_.size()) cpu_to_queue_.resize(idx + 1, -1);
+          cpu_to_queue_[idx] = static_cast<int>(ni % used);
         }
+      }
+      groups.resize(used);
+    }
+    if (groups.empty()) groups.push_back(opts.cpus);
+
+    queues_.reserve(groups.size());
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+      queues_.push_back(std::make_unique<node_queue>());
+      queues_.back()->index = i;
+    }
+
+    workers_.reserve(opts.threads);
+    for (std::size_t i = 0; i < opts.threads; ++i) {
+      const std::size_t qi = i % groups.size();
+      std::vector<int> pin;
+      const auto& cpus = groups[qi];
+      if (!cpus.empty()) {
+        if (opts.pin_per_cpu) pin.push_back(cpus[(i / groups.size()) % cpus.size()]);
+        else                  pin = cpus;
+      }
+      workers_.emplace_back([this, qi, pin = std::move(pin)]{
+        if (!pin.empty()) pin_current_thread(pin);
+        worker_loop(qi);
       });
     }
   }
 
   ~thread_pool() override {
-    {
-      std::lock_guard<std::mutex> lock(m_);
-      stop_ = true;
+    stop_.store(true, std::memory_order_release);
+    for (auto& q : queues_) {
+      { std::lock_guard<std::mutex> lock(q->m); }
+      q->cv.notify_all();
     }
-    cv_.notify_all();
     for (auto& t : workers_) if (t.joinable()) t.join();
+    // Whatever was posted after the workers left is discarded
+    for (auto& q : queues_) {
+      while (task_node* n = q->head) {
+        q->unlink(n);
+        if (n->group) n->group->detach(*n);
+        delete n;
+      }
+    }
   }
 
+  using executor::post;
+
   void post(std::function<void()> f) override {
+    auto* n = new task_node(std::move(f), nullptr);
+    auto& q = *queues_[pick_queue()];
+    bool has_idle = false;
     {
-      std::lock_guard<std::mutex> lock(m_);
-      q_.push(std::move(f));
+      std::lock_guard<std::mutex> lock(q.m);
+      has_idle = q.push(n);
+    }
+    wake(q, has_idle);
+  }
+
+  // Grouped tasks are linked into the group as well: cancel() unlinks the ones
+  // still queued, so workers never pop them.
+  void post(std::function<void()> f, std::shared_ptr<cancel_group> g) override {
+    if (!g) { post(std::move(f)); return; }
+    auto& q = *queues_[pick_queue()];
+    auto* n = new task_node(std::move(f), g);
+    n->q = &q;
+    n->pool = this;
+    bool has_idle = false;
+    const bool queued = g->attach(*n, [&]{
+      std::lock_guard<std::mutex> lock(q.m);
+      has_idle = q.push(n);
+    });
+    if (!queued) {
+      delete n;
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
     }
-    cv_.notify_one();
+    wake(q, has_idle);
   }
 
+  // True on the pool's own worker threads
+  bool running_in_this_thread() const noexcept override { return tl_pool_ == this; }
+
+  // Number of grouped tasks that were cancelled before they started.
+  std::size_t dropped_tasks() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+  // Number of per-node queues (1 unless numa_aware found several nodes).
+  std::size_t queue_count() const noexcept { return queues_.size(); }
+
   thread_pool(const thread_pool&) = delete;
   thread_pool& operator=(const thread_pool&) = delete;
 
 private:
-  std::mutex m_;
-  std::condition_variable cv_;
-  std::queue<std::function<void()>> q_;
+  struct node_queue;
+
+  struct task_node final : cancel_group::task_hook {
+    task_node(std::function<void()> f, std::shared_ptr<cancel_group> g)
+    : fn(std::move(f)), group(std::move(g)) {}
+
+    std::function<void()> fn;
+    std::shared_ptr<cancel_group> group;
+    thread_pool* pool{nullptr};
+    node_queue* q{nullptr};
+    task_node* prev{nullptr};
+    task_node* next{nullptr};
+    bool queued{false};        // linked into q (guarded by q->m)
+    std::atomic<int> state{0}; // grouped tasks: 0 - queued, 1 - running, 2 - cancelled
+
+    bool cancel_pending() noexcept override {
+      int expected = 0;
+      if (!state.compare_exchange_strong(expected, 2, std::memory_order_acq_rel)) return false;
+      {
+        std::lock_guard<std::mutex> lock(q->m);
+        if (queued) q->unlink(this);
+      }
+      pool->dropped_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+
+    void dispose() noexcept override { delete this; }
+  };
+
+  // Intrusive FIFO of tasks (O(1) unlink of any element)
+  struct node_queue {
+    std::mutex m;
+    std::condition_variable cv;
+    std::size_t index{0};
+    task_node* head{nullptr};
+    task_node* tail{nullptr};
+    std::atomic<std::size_t> size{0}; // hint for stealers, exact under m
+    std::size_t idle{0};
+    std::size_t steal_requests{0};
+
+    // returns true if a worker of this queue is idle
+    bool push(task_node* n) {
+      n->prev = tail;
+      n->next = nullptr;
+      if (tail) tail->next = n; else head = n;
+      tail = n;
+      n->queued = true;
+      size.fetch_add(1, std::memory_order_release);
+      return idle > 0;
+    }
+
+    void unlink(task_node* n) {
+      if (n->prev) n->prev->next = n->next; else head = n->next;
+      if (n->next) n->next->prev = n->prev; else tail = n->prev;
+      n->prev = n->next = nullptr;
+      n->queued = false;
+      size.fetch_sub(1, std::memory_order_release);
+    }
+
+    // Next runnable task; grouped tasks are claimed so cancel() can no longer drop them
+    task_node* pop() {
+      while (task_node* n = head) {
+        unlink(n);
+        if (!n->group) return n;
+        int expected = 0;
+        if (n->state.compare_exchange_strong(expected, 1, std::memory_order_acq_rel)) return n;
+        // being cancelled concurrently - the canceller frees it
+      }
+      return nullptr;
+    }
+  };
+
+  // Queue index of the calling worker (if it belongs to this pool)
+  static inline thread_local const thread_pool* tl_pool_ = nullptr;
+  static inline thread_local std::size_t tl_queue_ = 0;
+
+  std::size_t pick_queue() noexcept {
+    if (queues_.size() == 1) return 0;
+    if (tl_pool_ == this) return tl_queue_;
+    if (prefer_caller_node_) {
+      const int cpu = current_cpu();
+      if (cpu >= 0 && static_cast<std::size_t>(cpu) < cpu_to_queue_.size()) {
+        const int qi = cpu_to_queue_[static_cast<std::size_t>(cpu)];
+        if (qi >= 0) return static_cast<std::size_t>(qi);
+      }
+    }
+    return rr_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+  }
+
+  void wake(node_queue& q, bool has_idle) {
+    if (has_idle) {
+      q.cv.notify_one();
+      return;
+    }
+    // All workers of that node are busy - let an idle worker of another node steal it
+    for (std::size_t k = 1; k < queues_.size(); ++k) {
+      auto& other = *queues_[(q.index + k) % queues_.size()];
+      {
+        std::lock_guard<std::mutex> lock(other.m);
+        if (other.idle == 0) continue;
+        ++other.steal_requests;
+      }
+      other.cv.notify_one();
+      return;
+    }
+  }
+
+  task_node* try_pop(node_queue& q) {
+    if (q.size.load(std::memory_order_acquire) == 0) return nullptr;
+    std::lock_guard<std::mutex> lock(q.m);
+    return q.pop();
+  }
+
+  // Whether another queue has work (checked by a worker about to sleep)
+  bool work_elsewhere(std::size_t self) const noexcept {
+    for (std::size_t k = 1; k < queues_.size(); ++k) {
+      if (queues_[(self + k) % queues_.size()]->size.load(std::memory_order_acquire) != 0) return true;
+    }
+    return false;
+  }
+
+  task_node* try_steal(std::size_t self) {
+    for (std::size_t k = 1; k < queues_.size(); ++k) {
+      if (auto* n = try_pop(*queues_[(self + k) % queues_.size()])) return n;
+    }
+    return nullptr;
+  }
+
+  static void run(task_node* n) {
+    n->fn();
+    if (n->group) n->group->detach(*n);
+    delete n;
+  }
+
+  void worker_loop(std::size_t qi) {
+    tl_pool_  = this;
+    tl_queue_ = qi;
+    auto& own = *queues_[qi];
+    for (;;) {
+      // Own node first, then other nodes, and only then go to sleep
+      task_node* task = try_pop(own);
+      if (!task) task = try_steal(qi);
+      if (task) {
+        run(task);
+        continue;
+      }
+      {
+        std::unique_lock<std::mutex> lock(own.m);
+        // Once idle is raised, a post elsewhere either sees it (and sends a
+        // steal request) or was queued before - re-checking the other queues
+        // under own.m closes the gap since try_steal() above
+        ++own.idle;
+        own.cv.wait(lock, [&]{
+          return stop_.load(std::memory_order_acquire) || own.head != nullptr || own.steal_requests > 0
+              || work_elsewhere(qi);
+        });
+        --own.idle;
+        task = own.pop();
+        if (!task && own.steal_requests > 0) --own.steal_requests;
+      }
+      if (!task) task = try_steal(qi);
+      if (!task) {
+        // On shutdown the remaining queued work is still executed
+        if (stop_.load(std::memory_order_acquire)) return;
+        continue;
+      }
+      run(task);
+    }
+  }
+
+  std::vector<std::unique_ptr<node_queue>> queues_;
+  std::vector<int> cpu_to_queue_;
   std::vector<std::thread> workers_;
-  bool stop_;
+  std::atomic<bool> stop_{false};
+  std::atomic<std::size_t> rr_{0};
+  std::atomic<std::size_t> dropped_{0};
+  bool prefer_caller_node_{true};
 };
 
 } // namespace pulse
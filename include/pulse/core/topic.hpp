@@ -1,13 +1,18 @@
 #pragma once
 #include <atomic>
+#include <concepts>
 #include <cstdint>
 #include <functional>
 #include <list>
 #include <memory>
+#include <optional>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <pulse/core/backpressure.hpp>
+#include <pulse/core/cancel_group.hpp>
+#include <pulse/core/latest_cell.hpp>
 #include <pulse/core/scheduler.hpp>
 #include <pulse/core/subscription.hpp>
 
@@ -18,25 +23,149 @@ struct priority {
   int value{0};
 };
 
+// Tag: the topic keeps its last published value, see topic::latest()
+struct keep_latest_t {
+  explicit keep_latest_t() = default;
+};
+inline constexpr keep_latest_t keep_latest{};
+
 // Method presence detector BP::publish(const T&, Executor&, Invoke)
 namespace detail {
 template <class BP, class T, class Exec, class Invoke>
 concept has_bp_publish = requires(BP bp, const T &v, Exec &ex, Invoke inv) {
   { bp.publish(v, ex, inv) };
 };
+
+// Same, with the subscriber's cancel_group as a fourth argument: policies that
+// post from elsewhere later (timers) use it to stop once the subscriber is gone
+template <class BP, class T, class Exec, class Invoke>
+concept has_bp_publish_grouped = requires(BP bp, const T &v, Exec &ex, Invoke inv,
+                                          std::shared_ptr<cancel_group> g) {
+  { bp.publish(v, ex, inv, g) };
+};
+
+template <class BP>
+concept has_bp_stats = requires(const BP &bp) {
+  { bp.stats() } -> std::convertible_to<bp_stats>;
+};
+
+template <class BP> struct shared_policy {
+  using type = BP;
+  // Copy the configuration when possible; non-copyable policies start fresh
+  static std::shared_ptr<BP> make(BP &bp) {
+    if constexpr (std::is_copy_constructible_v<BP>)
+      return std::make_shared<BP>(bp);
+    else if constexpr (std::is_move_constructible_v<BP>)
+      return std::make_shared<BP>(std::move(bp));
+    else
+      return std::make_shared<BP>();
+  }
+};
+
+// A policy passed as shared_ptr is used as is, so the caller keeps a handle
+// to it (e.g. to read its stats())
+template <class BP> struct shared_policy<std::shared_ptr<BP>> {
+  using type = BP;
+  static std::shared_ptr<BP> make(const std::shared_ptr<BP> &bp) { return bp; }
+};
 } // namespace detail
 
+// Telemetry of one topic subscriber, see topic::stats()
+struct subscriber_stats {
+  std::uint64_t id{};
+  int priority{};
+  bp_stats bp{};
+};
+
 template <class T> class topic {
 public:
   topic() = default;
+  explicit topic(keep_latest_t) : latest_(std::make_unique<latest_cell<T>>()) {}
   topic(const topic &) = delete;
   topic &operator=(const topic &) = delete;
 
   // Subscription: If the BP has a publish(...) method, use it; otherwise
-  // ask for accept().
+  // ask for accept(). bp may also be a std::shared_ptr to a policy the caller
+  // wants to keep a handle to.
   template <class Fn, class BP = bp_none>
   subscription subscribe(executor &exec, priority prio, BP bp, Fn &&fn) {
+    return subscribe_impl(exec, prio, bp, std::forward<Fn>(fn), false);
+  }
+
+  // With inline_if_current, accept()-mode deliveries run directly inside
+  // publish() when it is called on a thread of exec (no queue round trip).
+  // Policies with their own publish(...) keep scheduling as they see fit.
+  template <class Fn, class BP = bp_none>
+  subscription subscribe(executor &exec, priority prio, BP bp, Fn &&fn, inline_if_current_t) {
+    return subscribe_impl(exec, prio, bp, std::forward<Fn>(fn), true);
+  }
+
+  // Last published value, readable from any thread without subscribing.
+  // Only kept by topics constructed with keep_latest; empty otherwise.
+  std::optional<T> latest() const {
+    if (!latest_)
+      return std::nullopt;
+    return latest_->load();
+  }
+
+  // Backpressure counters of every active subscriber, in delivery order.
+  // Subscribers whose policy has no stats() report zeros. Like subscribe(),
+  // call it from the publishing thread; to monitor one subscriber from another
+  // thread, subscribe with a std::shared_ptr policy and read its stats().
+  std::vector<subscriber_stats> stats() const {
+    std::vector<subscriber_stats> out;
+    for (const auto &n : nodes_) {
+      if (!n.enabled)
+        continue;
+      out.push_back(subscriber_stats{n.id, n.prio, n.stats ? n.stats() : bp_stats{}});
+    }
+    return out;
+  }
+
+  // Publish an event
+  void publish(const T &value) {
+    if (latest_)
+      latest_->store(value);
+    for (auto it = nodes_.begin(); it != nodes_.end(); ++it) {
+      if (!it->enabled)
+        continue;
+
+      auto *ex = it->exec;
+      auto inv = it->fn;
+
+      if (it->bp_publish) {
+        // The policy itself will decide when and what to do (coalescing, etc.)
+        it->bp_publish(value, *ex, inv);
+      } else {
+        // Simple accept() mode: either post a handler or drop it
+        if (it->bp_accept && !it->bp_accept())
+          continue;
+        if (it->serial) {
+          // inline_if_current: only while nothing of this subscriber is queued
+          // or being delivered, otherwise the delivery would overtake (or run
+          // next to) earlier events
+          it->serial->run(*ex, [inv, value] { inv(value); }, it->group);
+          continue;
+        }
+        ex->post([inv, value] { inv(value); }, it->group);
+      }
+    }
+
+    // Clearing disabled
+    for (auto it = nodes_.begin(); it != nodes_.end();) {
+      if (!it->enabled)
+        it = nodes_.erase(it);
+      else
+        ++it;
+    }
+  }
+
+private:
+  template <class Fn, class BPArg>
+  subscription subscribe_impl(executor &exec, priority prio, BPArg &bp_arg, Fn &&fn,
+                              bool inline_current) {
     using FnT = std::decay_t<Fn>;
+    using BP = typename detail::shared_policy<BPArg>::type;
 
     Node node{};
     node.id = next_id_.fetch_add(1, std::memory_order_relaxed);
@@ -44,22 +173,33 @@ public:
     node.prio = prio.value;
     node.exec = &exec;
     node.fn = [f = FnT(std::forward<Fn>(fn))](const T &v) { f(v); };
+    node.group = std::make_shared<cancel_group>();
+    if (inline_current)
+      node.serial = std::make_shared<detail::inline_serializer>();
     node.enabled = true;
 
-    if constexpr (detail::has_bp_publish<BP, T, executor,
-                                         std::function<void(const T &)>>) {
-      // Put the policy in shared_ptr so that the lambda in std::function is
-      // copied
-      auto sp = std::make_shared<BP>(); // don't pass bp (it may be 
-                                        // non-copyable/non-movable)
+    // The policy lives in a shared_ptr so that the lambdas in std::function
+    // are copyable and stats() can be read after subscribe
+    std::shared_ptr<BP> sp = detail::shared_policy<BPArg>::make(bp_arg);
+    if constexpr (detail::has_bp_publish_grouped<BP, T, executor,
+                                                 std::function<void(const T &)>>) {
+      node.bp_publish =
+          [sp, g = node.group](const T &v, executor &ex,
+                               const std::function<void(const T &)> &inv) mutable {
+            sp->publish(v, ex, inv, g);
+          };
+    } else if constexpr (detail::has_bp_publish<BP, T, executor,
+                                                std::function<void(const T &)>>) {
       node.bp_publish =
           [sp](const T &v, executor &ex,
                const std::function<void(const T &)> &inv) mutable {
             sp->publish(v, ex, inv);
           };
     } else {
-      node.bp_accept = [bp = std::move(bp)]() mutable { return bp.accept(); };
+      node.bp_accept = [sp]() mutable { return sp->accept(); };
     }
+    if constexpr (detail::has_bp_stats<BP>)
+      node.stats = [sp] { return sp->stats(); };
 
     // Insert by (priority desc, order_id asc)
     auto it = nodes_.begin();
@@ -76,42 +216,13 @@ public:
       for (auto &n : nodes_) {
         if (n.id == my_id) {
           n.enabled = false;
+          n.group->cancel(); // deliveries still queued in the executor are dropped
           break;
         }
       }
     });
   }
 
-  // Publish an event
-  void publish(const T &value) {
-    for (auto it = nodes_.begin(); it != nodes_.end(); ++it) {
-      if (!it->enabled)
-        continue;
-
-      auto *ex = it->exec;
-      auto inv = it->fn;
-
-      if (it->bp_publish) {
-        // The policy itself will decide when and what to do (coalescing, etc.)
-        it->bp_publish(value, *ex, inv);
-      } else {
-        // Simple accept() mode: either post a handler or drop it
-        if (it->bp_accept && !it->bp_accept())
-          continue;
-        ex->post([inv, value] { inv(value); });
-      }
-    }
-
-    // Clearing disabled
-    for (auto it = nodes_.begin(); it != nodes_.end();) {
-      if (!it->enabled)
-        it = nodes_.erase(it);
-      else
-        ++it;
-    }
-  }
-
-private:
   struct Node {
     std::uint64_t id{};
     std::uint64_t order_id{};
@@ -124,11 +235,19 @@ private:
                        const std::function<void(const T &)> &)>
         bp_publish{};
     std::function<bool()> bp_accept{};
+    // Set if the policy keeps counters
+    std::function<bp_stats()> stats{};
+
+    // Pending accept()-mode deliveries of this subscriber
+    std::shared_ptr<cancel_group> group{};
+    // Set only for inline_if_current subscribers
+    std::shared_ptr<detail::inline_serializer> serial{};
 
     bool enabled{false};
   };
 
   std::list<Node> nodes_{};
+  std::unique_ptr<latest_cell<T>> latest_{};
   std::atomic_uint64_t next_id_{1};
   std::atomic_uint64_t order_ctr_{1};
 };
@@ -2,14 +2,27 @@
 #include <pulse/core/topic.hpp>
 #include <pulse/core/observable.hpp>
 #include <pulse/core/backpressure.hpp>
+#include <pulse/core/demand.hpp>
+#include <memory>
 
 namespace pulse {
 
-// Simple adapter: turn topic<T> into observable<T> by subscribing to the specified executor
+// Simple adapter: turn topic<T> into observable<T> by subscribing to the specified executor.
+// With flow control (subscribe(..., demand)) deliveries beyond the credit wait in a
+// per-subscriber gate until requested; opts bounds that buffer.
 template <class T>
-inline observable<T> as_observable(topic<T>& t, executor& ex) {
-  return observable<T>::create([&t, &ex](auto on_next, auto, auto){
-    return t.subscribe(ex, priority{0}, bp_none{}, [on_next](const T& v){ on_next(v); });
+inline observable<T> as_observable(topic<T>& t, executor& ex, flow_options opts = {}) {
+  return observable<T>::create_flow([&t, &ex, opts](auto on_next, auto on_err, auto on_done,
+                                                    std::shared_ptr<demand> d){
+    if (!d)
+      return t.subscribe(ex, priority{0}, bp_none{}, [on_next](const T& v){ on_next(v); });
+
+    auto g = std::make_shared<detail::flow_gate<T>>(std::move(on_next), std::move(on_err),
+                                                    std::move(on_done), std::move(d), opts);
+    g->open();
+    auto inner = std::make_shared<subscription>(
+      t.subscribe(ex, priority{0}, bp_none{}, [g](const T& v){ g->push_next(v); }));
+    return subscription([g, inner]{ inner->reset(); g->close(); });
   });
 }
 
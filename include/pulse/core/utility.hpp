@@ -1 +1,43 @@
-//TODO: Implement in the future
\ No newline at end of file
+#pragma once
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace pulse {
+namespace detail {
+
+// Atomic std::shared_ptr cell: readers take a reference without locking the
+// writer's mutex. Uses std::atomic<std::shared_ptr> where the standard library
+// provides it, otherwise the (pre-C++20) atomic_load/atomic_store overloads.
+template <class T>
+class atomic_shared {
+public:
+  atomic_shared() = default;
+  explicit atomic_shared(std::shared_ptr<T> p) : p_(std::move(p)) {}
+
+  atomic_shared(const atomic_shared&) = delete;
+  atomic_shared& operator=(const atomic_shared&) = delete;
+
+#if defined(__cpp_lib_atomic_shared_ptr)
+  std::shared_ptr<T> load() const noexcept { return p_.load(std::memory_order_acquire); }
+  void store(std::shared_ptr<T> p) noexcept { p_.store(std::move(p), std::memory_order_release); }
+  std::shared_ptr<T> exchange(std::shared_ptr<T> p) noexcept {
+    return p_.exchange(std::move(p), std::memory_order_acq_rel);
+  }
+
+private:
+  std::atomic<std::shared_ptr<T>> p_;
+#else
+  std::shared_ptr<T> load() const noexcept { return std::atomic_load(&p_); }
+  void store(std::shared_ptr<T> p) noexcept { std::atomic_store(&p_, std::move(p)); }
+  std::shared_ptr<T> exchange(std::shared_ptr<T> p) noexcept {
+    return std::atomic_exchange(&p_, std::move(p));
+  }
+
+private:
+  std::shared_ptr<T> p_;
+#endif
+};
+
+} // namespace detail
+} // namespace pulse
@@ -0,0 +1,94 @@
+#pragma once
+#include <pulse/core/observable.hpp>
+#include <pulse/core/subscription.hpp>
+#include <pulse/core/lru_cache.hpp>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pulse {
+
+// cached<T>(f, capacity, ttl): f (T -> observable<U>) memoized by its argument.
+// A call whose inner observable completed is kept in an lru_cache (values in
+// order, at most `capacity` arguments, each for `ttl`; zero = no expiry); a
+// later subscription for the same argument replays the values and completes
+// synchronously, without calling f. Misses run f as usual and forward its values
+// live; only completed calls are cached - errors and calls cancelled before
+// they completed are not. The check happens at subscription, so the wrapper can
+// replace f in switch_map/concat_map/merge_map as is. Copies share the cache;
+// stats() reports its hits, misses, evictions and expirations.
+template <class T, class Fn, class Hash = std::hash<T>, class Eq = std::equal_to<T>>
+class cached_fn {
+public:
+  using inner_observable = std::decay_t<std::invoke_result_t<const Fn&, const T&>>;
+  using value_type = typename inner_observable::value_type;
+  using cache_type = lru_cache<T, std::shared_ptr<const std::vector<value_type>>, Hash, Eq>;
+
+  cached_fn(Fn f, std::size_t capacity, std::chrono::steady_clock::duration ttl)
+    : f_(std::move(f)), cache_(std::make_shared<cache_type>(capacity, ttl)) {}
+
+  inner_observable operator()(const T& arg) const {
+    using U = value_type;
+    return inner_observable::create([f = f_, cache = cache_, arg](auto on_next, auto on_err, auto on_done){
+      if (auto hit = cache->get(arg)) {
+        for (const U& v : **hit) if (on_next) on_next(v);
+        if (on_done) on_done();
+        return subscription{};
+      }
+
+      struct miss {
+        std::mutex m;
+        std::vector<U> values;
+      };
+      auto rec = std::make_shared<miss>();
+      std::optional<inner_observable> inner;
+      try {
+        inner.emplace(f(arg));
+      } catch (...) {
+        if (on_err) on_err(std::current_exception());
+        return subscription{};
+      }
+      return inner->subscribe(
+        [rec, on_next](const U& v){
+          {
+            std::lock_guard<std::mutex> lock(rec->m);
+            rec->values.push_back(v);
+          }
+          if (on_next) on_next(v);
+        },
+        on_err,
+        [rec, cache, arg, on_done]{
+          std::vector<U> values;
+          {
+            std::lock_guard<std::mutex> lock(rec->m);
+            values.swap(rec->values);
+          }
+          cache->put(arg, std::make_shared<const std::vector<U>>(std::move(values)));
+          if (on_done) on_done();
+        });
+    });
+  }
+
+  cache_stats stats() const { return cache_->stats(); }
+
+  // Drops every cached result (e.g. after the backend data changed)
+  void invalidate() const { cache_->clear(); }
+
+private:
+  Fn f_;
+  std::shared_ptr<cache_type> cache_;
+};
+
+template <class T, class Fn>
+auto cached(Fn f, std::size_t capacity, std::chrono::steady_clock::duration ttl) {
+  return cached_fn<T, std::decay_t<Fn>>(std::move(f), capacity, ttl);
+}
+
+} // namespace pulse
@@ -2,91 +2,238 @@
 #include <pulse/core/observable.hpp>
 #include <pulse/core/subscription.hpp>
 #include <pulse/core/composite_subscription.hpp>
-#include <optional>
+#include <pulse/core/cancel_group.hpp>
+#include <pulse/core/scheduler.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
 namespace pulse {
 
-// combine_latest(oa, ob, f): when both have the latest values,
-// calls on_next(f(a, b)) on each new event from either stream.
-// Completes when BOTH sources have completed. Throws an error immediately.
-template <class A, class B, class F>
-auto combine_latest(const observable<A>& oa, const observable<B>& ob, F f) {
-  using R = std::invoke_result_t<F, const A&, const B&>;
-  return observable<R>::create([oa, ob, f = std::move(f)](auto on_next, auto on_err, auto on_done){
-    struct state_t {
-      std::mutex m;
-      std::optional<A> lastA;
-      std::optional<B> lastB;
-      bool doneA{false};
-      bool doneB{false};
-    };
-    auto st = std::make_shared<state_t>();
-    auto comp = std::make_shared<composite_subscription>();
-
-    auto try_emit = [st, on_next, &f](){
-      std::optional<R> out;
-      {
-        std::lock_guard<std::mutex> lock(st->m);
-        if (st->lastA && st->lastB) {
-          out.emplace(f(*st->lastA, *st->lastB));
-        }
+// Tag for combine_latest: recompute on ex, once per executor turn, no matter
+// how many inputs changed since the last recomputation.
+struct coalesce_on_t {
+  executor* ex;
+};
+inline coalesce_on_t coalesce_on(executor& ex) { return coalesce_on_t{ &ex }; }
+
+namespace detail {
+
+// One input of combine_latest: the latest value behind its own small lock, so
+// sources never contend with each other and the lock is held only for a copy.
+template <class T>
+struct latest_slot {
+  std::mutex m;
+  std::optional<T> value;
+};
+
+// Shared state of combine_latest(f, o1, ..., oN). Every source writes its
+// latest value into its own slot and sets its bit in `dirty`; the
+// recomputation copies only the dirty slots into its cache and calls f on the
+// cache without holding any lock. Recomputations are serialized (wip/missed),
+// so updates that arrive while f runs are folded into one more recomputation.
+template <class R, class F, class... Ts>
+struct combine_latest_state : std::enable_shared_from_this<combine_latest_state<R, F, Ts...>> {
+  static constexpr std::size_t N = sizeof...(Ts);
+  static_assert(N >= 1 && N <= 64, "combine_latest takes 1..64 sources");
+  using seq = std::index_sequence_for<Ts...>;
+
+  combine_latest_state(F fn, executor* e) : f(std::move(fn)), ex(e) {}
+
+  F f;
+  executor* ex;                                       // null: recompute on the updating thread
+  std::tuple<latest_slot<Ts>...> slots;
+  std::atomic<std::uint64_t> dirty{0};
+  std::atomic<std::size_t> completed{0};
+  std::atomic<bool> failing{false};                   // first error wins
+  std::atomic<bool> failed{false};
+  std::exception_ptr error;                           // written before `failed`
+  typename observable<R>::OnNext on_next;
+  typename observable<R>::OnErr  on_err;
+  typename observable<R>::OnDone on_done;
+  std::shared_ptr<composite_subscription> comp = std::make_shared<composite_subscription>();
+  std::shared_ptr<cancel_group> group = std::make_shared<cancel_group>();
+
+  std::atomic<bool> alive{true};
+  std::atomic<bool> scheduled{false};                 // coalesce_on: a turn is pending
+  std::atomic<int> wip{0};
+  std::tuple<std::optional<Ts>...> cache;             // drain side only
+
+  template <std::size_t I, class T>
+  void update(const T& v) {
+    if (!alive.load(std::memory_order_acquire)) return;
+    if (!ex) {
+      // Nobody is recomputing: take over and write straight into the cache
+      // (any earlier slot update was consumed before wip dropped to zero)
+      int idle = 0;
+      if (wip.compare_exchange_strong(idle, 1, std::memory_order_acq_rel)) {
+        std::get<I>(cache) = v;
+        run(true);
+        return;
+      }
+    }
+    {
+      auto& slot = std::get<I>(slots);
+      std::lock_guard<std::mutex> lock(slot.m);
+      slot.value = v;
+    }
+    dirty.fetch_or(std::uint64_t{1} << I, std::memory_order_acq_rel);
+    trigger();
+  }
+
+  void complete_source() {
+    completed.fetch_add(1, std::memory_order_acq_rel);
+    trigger();
+  }
+
+  void fail(std::exception_ptr e) {
+    if (failing.exchange(true, std::memory_order_acq_rel)) return;
+    error = e;
+    failed.store(true, std::memory_order_release);
+    trigger();
+  }
+
+  void trigger() {
+    if (!ex) { drain(); return; }
+    if (scheduled.exchange(true, std::memory_order_acq_rel)) return;
+    ex->post([self = this->shared_from_this()]{
+      self->scheduled.store(false, std::memory_order_release);
+      self->drain();
+    }, group);
+  }
+
+  void drain() {
+    if (wip.fetch_add(1, std::memory_order_acq_rel) != 0) return;
+    run(false);
+  }
+
+  // Recomputation loop; the caller holds one unit of wip
+  void run(bool changed) {
+    int missed = 1;
+    for (;;) {
+      if (!alive.load(std::memory_order_acquire)) return;
+      if (failed.load(std::memory_order_acquire)) {
+        finish(error);
+        return;
       }
-      if (out && on_next) on_next(*out);
-    };
-
-    auto subA = oa.subscribe(
-      // on_next A
-      [st, try_emit](const A& a){
-        { std::lock_guard<std::mutex> lock(st->m); st->lastA = a; }
-        try_emit();
-      },
-      // on_error
-      [comp, on_err](std::exception_ptr e){
-        if (on_err) on_err(e);
-        comp->reset();
-      },
-      // on_done A
-      [st, comp, on_done]{
-        bool both_done = false;
-        {
-          std::lock_guard<std::mutex> lock(st->m);
-          st->doneA = true;
-          both_done = st->doneA && st->doneB;
-        }
-        if (both_done) { if (on_done) on_done(); comp->reset(); }
+      if (dirty.load(std::memory_order_acquire) != 0) {
+        refresh(dirty.exchange(0, std::memory_order_acq_rel), seq{});
+        changed = true;
       }
-    );
-
-    auto subB = ob.subscribe(
-      // on_next B
-      [st, try_emit](const B& b){
-        { std::lock_guard<std::mutex> lock(st->m); st->lastB = b; }
-        try_emit();
-      },
-      // on_error
-      [comp, on_err](std::exception_ptr e){
-        if (on_err) on_err(e);
-        comp->reset();
-      },
-      // on_done B
-      [st, comp, on_done]{
-        bool both_done = false;
-        {
-          std::lock_guard<std::mutex> lock(st->m);
-          st->doneB = true;
-          both_done = st->doneA && st->doneB;
-        }
-        if (both_done) { if (on_done) on_done(); comp->reset(); }
+      if (changed && ready(seq{})) emit(seq{});
+      changed = false;
+      if (completed.load(std::memory_order_acquire) == N &&
+          dirty.load(std::memory_order_acquire) == 0) {
+        finish(nullptr);
+        return;
       }
-    );
+      missed = wip.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+      if (missed == 0) break;
+    }
+  }
 
-    comp->add(std::move(subA));
-    comp->add(std::move(subB));
-    return subscription([comp]{ comp->reset(); });
+  template <std::size_t... I>
+  void refresh(std::uint64_t mask, std::index_sequence<I...>) {
+    ((mask & (std::uint64_t{1} << I) ? refresh_one<I>() : void()), ...);
+  }
+
+  template <std::size_t I>
+  void refresh_one() {
+    auto& slot = std::get<I>(slots);
+    std::lock_guard<std::mutex> lock(slot.m);
+    std::get<I>(cache) = slot.value;
+  }
+
+  template <std::size_t... I>
+  bool ready(std::index_sequence<I...>) const {
+    return (std::get<I>(cache).has_value() && ...);
+  }
+
+  template <std::size_t... I>
+  void emit(std::index_sequence<I...>) {
+    std::optional<R> out;
+    try {
+      out.emplace(f(*std::get<I>(cache)...));
+    } catch (...) {
+      finish(std::current_exception());
+      return;
+    }
+    if (on_next) on_next(*out);
+  }
+
+  void finish(std::exception_ptr e) {
+    if (!alive.exchange(false, std::memory_order_acq_rel)) return;
+    group->cancel();
+    if (e) { if (on_err) on_err(e); }
+    else if (on_done) on_done();
+    comp->reset();
+  }
+};
+
+template <class R, class F, class... Ts, std::size_t... I>
+void combine_latest_subscribe_all(const std::shared_ptr<combine_latest_state<R, F, Ts...>>& st,
+                                  const std::tuple<observable<Ts>...>& sources,
+                                  std::index_sequence<I...>) {
+  // Strong captures: the cycle through comp is broken on termination or cancel
+  (st->comp->add(std::get<I>(sources).subscribe(
+     [st](const Ts& v){ st->template update<I>(v); },
+     [st](std::exception_ptr e){ st->fail(e); },
+     [st]{ st->complete_source(); })), ...);
+}
+
+template <class F, class... Ts>
+auto combine_latest_impl(executor* ex, F f, const observable<Ts>&... sources) {
+  using R = std::decay_t<std::invoke_result_t<F&, const Ts&...>>;
+  return observable<R>::create([ex, f = std::move(f), srcs = std::make_tuple(sources...)](
+                                 auto on_next, auto on_err, auto on_done){
+    using state_t = combine_latest_state<R, F, Ts...>;
+    auto st = std::make_shared<state_t>(f, ex);
+    st->on_next = std::move(on_next);
+    st->on_err  = std::move(on_err);
+    st->on_done = std::move(on_done);
+    combine_latest_subscribe_all(st, srcs, std::index_sequence_for<Ts...>{});
+    return subscription([st]{
+      st->alive.store(false, std::memory_order_release);
+      st->group->cancel();
+      st->comp->reset();
+    });
   });
 }
 
+} // namespace detail
+
+// combine_latest(f, o1, ..., oN): once every source has a value, emits
+// f(latest1, ..., latestN) after each update. f runs outside any lock; updates
+// that arrive while it runs are combined into one recomputation with the
+// newest values. Completes when ALL sources have completed; errors (from a
+// source or f) end the stream at the next recomputation and cancel the rest.
+template <class F, class... Ts>
+  requires (!detail::is_observable<std::decay_t<F>>::value &&
+            !std::is_same_v<std::decay_t<F>, coalesce_on_t>)
+auto combine_latest(F f, const observable<Ts>&... sources) {
+  return detail::combine_latest_impl(nullptr, std::move(f), sources...);
+}
+
+// combine_latest(coalesce_on(ex), f, o...): updates only mark their input dirty
+// and schedule one recomputation on ex; a burst of updates within one executor
+// turn yields a single f call and a single emission (delivered on ex).
+// IMPORTANT: ex must outlive the subscription!
+template <class F, class... Ts>
+auto combine_latest(coalesce_on_t c, F f, const observable<Ts>&... sources) {
+  return detail::combine_latest_impl(c.ex, std::move(f), sources...);
+}
+
+// combine_latest(oa, ob, f): the two-source form
+template <class A, class B, class F>
+auto combine_latest(const observable<A>& oa, const observable<B>& ob, F f) {
+  return detail::combine_latest_impl(nullptr, std::move(f), oa, ob);
+}
+
 } // namespace pulse
@@ -1,14 +1,19 @@
 #pragma once
 #include <pulse/core/observable.hpp>
 #include <pulse/core/subscription.hpp>
+#include <pulse/core/demand.hpp>
 
 #include <functional>
 #include <memory>
 #include <deque>
 #include <atomic>
+#include <cstddef>
 #include <exception>
+#include <mutex>
+#include <optional>
 #include <utility>
 #include <type_traits>
+#include <vector>
 
 namespace pulse {
 
@@ -21,12 +26,18 @@ struct op_concat_map {
     using inner_observable = decltype(fn(std::declval<T>()));
     using U = typename inner_observable::value_type;
 
-    return observable<U>::create([src, fn = fn](auto on_next, auto on_error, auto on_completed) {
+    return observable<U>::create_flow([src, fn = fn](auto on_next, auto on_error, auto on_completed,
+                                                     std::shared_ptr<demand> d) {
       struct state {
         std::atomic<bool> alive{true};
         bool outer_completed = false;
         bool inner_active = false;
 
+        // With flow control the outer source is asked for one value at a time
+        // (the queue stays at most one deep) and the inner one gets the downstream demand.
+        std::shared_ptr<demand> down;
+        std::shared_ptr<demand> outer;
+
         std::deque<inner_observable> queue;
         subscription sub_up;
         subscription sub_in;
@@ -36,6 +47,10 @@ struct op_concat_map {
 
       auto st = std::make_shared<state>();
       auto wst = std::weak_ptr<state>(st);
+      if (d) {
+        st->down = d;
+        st->outer = std::make_shared<demand>();
+      }
 
       st->drain = [wst, on_next, on_error, on_completed]() mutable {
         auto s = wst.lock();
@@ -78,8 +93,10 @@ struct op_concat_map {
               s2->sub_in.reset();
               s2->inner_active = false;
               s2->drain();
+              if (s2->outer && !s2->outer_completed) s2->outer->request(1);
             }
-          }
+          },
+          s->down
         );
       };
 
@@ -114,8 +131,10 @@ struct op_concat_map {
           if (!st->alive) return;
           st->outer_completed = true;
           st->drain();
-        }
+        },
+        st->outer
       );
+      if (st->outer) st->outer->request(1);
 
       return subscription([st]{
         if (!st) return;
@@ -133,4 +152,259 @@ inline auto concat_map(Fn fn) {
   return op_concat_map<std::decay_t<Fn>>{ std::forward<Fn>(fn) };
 }
 
+// concat_map_eager(f, prefetch): same output as concat_map, but subscribes to up
+// to `prefetch` inner observables at once. Only the oldest one emits downstream;
+// the values of the ones behind it are buffered (in full, they are not throttled)
+// until it completes. Inner latencies overlap instead of adding up.
+// The outer source is asked for `prefetch` values up front and for one more per
+// finished inner observable. An inner error is delivered when its observable
+// becomes the oldest, after everything before it (as with concat_map); outer
+// errors and errors thrown by f cancel everything right away.
+template <class Fn>
+struct op_concat_map_eager {
+  Fn fn;
+  std::size_t prefetch;
+
+  template <class T>
+  auto operator()(const observable<T>& src) const {
+    using inner_observable = decltype(fn(std::declval<T>()));
+    using U = typename inner_observable::value_type;
+
+    return observable<U>::create_flow([src, fn = fn, k = prefetch](auto on_next, auto on_error,
+                                                                   auto on_completed,
+                                                                   std::shared_ptr<demand> d) {
+      struct slot {
+        std::deque<U> values;
+        bool done{false};
+        std::exception_ptr error;
+        subscription sub;
+      };
+
+      struct state : std::enable_shared_from_this<state> {
+        state(Fn f, std::size_t limit) : fn(std::move(f)), k(limit ? limit : 1) {}
+
+        Fn fn;
+        std::size_t k;
+        typename observable<U>::OnNext on_next;
+        typename observable<U>::OnErr  on_err;
+        typename observable<U>::OnDone on_done;
+        std::shared_ptr<demand> down;                        // null: no flow control
+        demand::listener down_listener;
+        std::shared_ptr<demand> outer = std::make_shared<demand>();
+
+        std::mutex m;
+        bool alive{true};
+        bool outer_completed{false};
+        std::deque<std::shared_ptr<slot>> active;            // subscribed inners, oldest first
+        std::deque<T> pending;                               // outer values waiting for a slot
+        subscription sub_up;                                 // guarded by m
+        std::atomic<int> wip{0};
+
+        void receive(const T& v) {
+          std::shared_ptr<slot> sl;
+          {
+            std::lock_guard<std::mutex> lock(m);
+            if (!alive) return;
+            if (active.size() >= k) {
+              pending.push_back(v);
+              return;
+            }
+            sl = std::make_shared<slot>();
+            active.push_back(sl);
+          }
+          start(v, sl);
+        }
+
+        void start(const T& v, const std::shared_ptr<slot>& sl) {
+          std::optional<inner_observable> inner;
+          try {
+            inner.emplace(fn(v));
+          } catch (...) {
+            fail(std::current_exception());
+            return;
+          }
+          std::weak_ptr<state> w = this->shared_from_this();
+          std::weak_ptr<slot> ws = sl;
+          auto sub = inner->subscribe(
+            [w, ws](const U& x){
+              auto s = w.lock();
+              auto p = ws.lock();
+              if (!s || !p) return;
+              {
+                std::lock_guard<std::mutex> lock(s->m);
+                if (!s->alive) return;
+                p->values.push_back(x);
+              }
+              s->drain();
+            },
+            [w, ws](std::exception_ptr e){ if (auto s = w.lock()) s->inner_done(ws, e); },
+            [w, ws]{ if (auto s = w.lock()) s->inner_done(ws, nullptr); });
+
+          std::lock_guard<std::mutex> lock(m);
+          if (alive && !sl->done) sl->sub = std::move(sub);
+          else if (alive) sub.release(); // completed synchronously
+          // else: cancelled meanwhile, `sub` cancels on destruction
+        }
+
+        void inner_done(const std::weak_ptr<slot>& ws, std::exception_ptr e) {
+          auto p = ws.lock();
+          if (!p) return;
+          {
+            std::lock_guard<std::mutex> lock(m);
+            if (!alive) return;
+            p->done = true;
+            p->error = e;
+          }
+          drain();
+        }
+
+        // Serialized emission (wip/missed): the oldest inner's buffered values,
+        // then the next one once it is done
+        void drain() {
+          if (wip.fetch_add(1, std::memory_order_acq_rel) != 0) return;
+          int missed = 1;
+          for (;;) {
+            for (;;) {
+              std::optional<U> v;
+              std::exception_ptr err;
+              std::vector<std::pair<T, std::shared_ptr<slot>>> launch;
+              bool completed = false, finished_inner = false;
+              subscription up;
+              {
+                std::lock_guard<std::mutex> lock(m);
+                if (!alive) return;
+                if (active.empty()) {
+                  if (!outer_completed || !pending.empty()) break;
+                  alive = false;
+                  completed = true;
+                  up = std::move(sub_up);
+                } else {
+                  auto& head = active.front();
+                  if (!head->values.empty()) {
+                    if (down && !down->try_consume()) break;
+                    v.emplace(std::move(head->values.front()));
+                    head->values.pop_front();
+                  } else if (head->done) {
+                    err = head->error;
+                    head->sub.release();
+                    active.pop_front();
+                    finished_inner = true;
+                    while (!err && active.size() < k && !pending.empty()) {
+                      auto sl = std::make_shared<slot>();
+                      active.push_back(sl);
+                      launch.emplace_back(std::move(pending.front()), std::move(sl));
+                      pending.pop_front();
+                    }
+                  } else {
+                    break;
+                  }
+                }
+              }
+              if (completed) {
+                detach_down();
+                up.release();
+                if (on_done) on_done();
+                return;
+              }
+              if (err) {
+                fail(err);
+                return;
+              }
+              if (v) {
+                if (on_next) on_next(*v);
+                continue;
+              }
+              if (finished_inner) {
+                for (auto& [x, sl] : launch) start(x, sl);
+                bool more;
+                {
+                  std::lock_guard<std::mutex> lock(m);
+                  more = alive && !outer_completed;
+                }
+                if (more) outer->request(1);
+              }
+            }
+            missed = wip.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+            if (missed == 0) break;
+          }
+        }
+
+        void outer_done() {
+          {
+            std::lock_guard<std::mutex> lock(m);
+            if (!alive) return;
+            outer_completed = true;
+          }
+          drain();
+        }
+
+        void fail(std::exception_ptr e) {
+          if (!cancel()) return;
+          if (on_err) on_err(e);
+        }
+
+        void detach_down() {
+          if (down && down_listener) down->remove(down_listener);
+        }
+
+        // Stops everything; false if already stopped
+        bool cancel() {
+          std::deque<std::shared_ptr<slot>> tmp;
+          subscription up;
+          {
+            std::lock_guard<std::mutex> lock(m);
+            if (!alive) return false;
+            alive = false;
+            pending.clear();
+            tmp.swap(active);
+            up = std::move(sub_up);
+          }
+          for (auto& sl : tmp) sl->sub.reset();
+          detach_down();
+          up.reset();
+          return true;
+        }
+
+        // Keeps the outer subscription unless everything stopped while
+        // subscribe() was still running: then it is dropped right away
+        void store_up(subscription s) {
+          {
+            std::lock_guard<std::mutex> lock(m);
+            if (alive) { sub_up = std::move(s); return; }
+            if (!outer_completed) return; // cancelled: `s` cancels on destruction
+          }
+          s.release(); // the outer source is done
+        }
+      };
+
+      auto st = std::make_shared<state>(fn, k);
+      st->on_next = std::move(on_next);
+      st->on_err  = std::move(on_error);
+      st->on_done = std::move(on_completed);
+      std::weak_ptr<state> wst = st;
+      if (d) {
+        st->down = std::move(d);
+        st->down_listener = st->down->on_request([wst](std::size_t){
+          if (auto s = wst.lock()) s->drain();
+        });
+      }
+
+      auto up = src.subscribe(
+        [wst](const T& v){ if (auto s = wst.lock()) s->receive(v); },
+        [wst](std::exception_ptr e){ if (auto s = wst.lock()) s->fail(e); },
+        [wst]{ if (auto s = wst.lock()) s->outer_done(); },
+        st->outer);
+      st->store_up(std::move(up));
+      st->outer->request(st->k);
+
+      return subscription([st]{ st->cancel(); });
+    });
+  }
+};
+
+template <class Fn>
+inline auto concat_map_eager(Fn fn, std::size_t prefetch) {
+  return op_concat_map_eager<std::decay_t<Fn>>{ std::forward<Fn>(fn), prefetch };
+}
+
 } // namespace pulse
@@ -1,5 +1,7 @@
 #pragma once
 #include <pulse/core/observable.hpp>
+#include <pulse/core/demand.hpp>
+#include <memory>
 #include <utility>
 
 namespace pulse {
@@ -9,10 +11,11 @@ struct op_filter {
   Pred p;
   template <class T>
   auto operator()(const observable<T>& src) const {
-    return observable<T>::create([src, p = p](auto on_next, auto on_err, auto on_done){
+    return observable<T>::create_flow([src, p = p](auto on_next, auto on_err, auto on_done, std::shared_ptr<demand> d){
       return src.subscribe(
-        [p, on_next](const T& v){ if (p(v)) on_next(v); },
-        on_err, on_done
+        // a dropped value used up one unit of credit upstream: give it back
+        [p, on_next, d](const T& v){ if (p(v)) on_next(v); else if (d) d->request(1); },
+        on_err, on_done, d
       );
     });
   }
@@ -0,0 +1,73 @@
+#pragma once
+#include <pulse/core/observable.hpp>
+#include <pulse/core/subscription.hpp>
+#include <pulse/core/demand.hpp>
+#include <atomic>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace pulse {
+
+// from_range(r): cold source emitting the elements of r, then on_completed.
+// Honors demand: with flow control it emits only as much as was requested and
+// resumes on the thread that calls request(n).
+template <std::ranges::forward_range R>
+inline auto from_range(R r) {
+  using T = std::remove_cvref_t<std::ranges::range_value_t<R>>;
+  auto data = std::make_shared<const R>(std::move(r));
+
+  return observable<T>::create_flow([data](auto on_next, auto, auto on_done, std::shared_ptr<demand> d) {
+    struct state {
+      std::shared_ptr<const R> data;
+      std::ranges::iterator_t<const R> it;
+      decltype(on_next) next;
+      decltype(on_done) done;
+      std::shared_ptr<demand> d;
+      demand::listener listener;
+      std::atomic<int> wip{0};
+      std::atomic<bool> cancelled{false};
+      bool finished{false}; // drain side only
+
+      void drain() {
+        if (wip.fetch_add(1, std::memory_order_acq_rel) != 0) return;
+        int missed = 1;
+        for (;;) {
+          while (!finished && !cancelled.load(std::memory_order_acquire)) {
+            if (it == std::ranges::end(*data)) {
+              finished = true;
+              if (done) done();
+              break;
+            }
+            if (d && !d->try_consume()) break;
+            T v = *it;
+            ++it;
+            if (next) next(v); // may call request() - picked up via `missed`
+          }
+          missed = wip.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+          if (missed == 0) break;
+        }
+      }
+    };
+
+    auto st = std::make_shared<state>();
+    st->data = data;
+    st->it = std::ranges::begin(*st->data);
+    st->next = std::move(on_next);
+    st->done = std::move(on_done);
+    st->d = std::move(d);
+    if (st->d) {
+      std::weak_ptr<state> w = st;
+      st->listener = st->d->on_request([w](std::size_t){ if (auto s = w.lock()) s->drain(); });
+    }
+    st->drain();
+
+    return subscription([st]{
+      st->cancelled.store(true, std::memory_order_release);
+      if (st->d) st->d->remove(st->listener);
+    });
+  });
+}
+
+} // namespace pulse
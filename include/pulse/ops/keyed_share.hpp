@@ -0,0 +1,151 @@
+#pragma once
+#include <pulse/core/observable.hpp>
+#include <pulse/core/subscription.hpp>
+#include <pulse/core/replay_subject.hpp>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace pulse {
+
+// keyed_share<K, U>: one in-flight inner observable per key. The first
+// subscriber for a key starts make(); everyone who subscribes for the same key
+// while it runs joins that call instead of starting another one (receiving the
+// last `replay` values it already emitted, then the rest). When the call
+// completes or fails the key is evicted, so the next subscriber starts a fresh
+// call; when every subscriber of a key has unsubscribed, the call is cancelled
+// and the key is evicted as well.
+// Copies share the same table.
+template <class K, class U, class Hash = std::hash<K>, class Eq = std::equal_to<K>>
+class keyed_share {
+public:
+  explicit keyed_share(std::size_t replay = 1) : st_(std::make_shared<state>(replay ? replay : 1)) {}
+
+  // The call for `key`: joins the running one or starts make() (-> observable<U>)
+  template <class Make>
+  observable<U> get(K key, Make make) const {
+    return observable<U>::create([st = st_, key = std::move(key), make = std::move(make)](
+                                   auto on_next, auto on_err, auto on_done){
+      std::shared_ptr<entry> e;
+      bool start = false;
+      {
+        std::lock_guard<std::mutex> lock(st->m);
+        auto& slot = st->live[key];
+        if (!slot) {
+          slot = std::make_shared<entry>(st->replay);
+          start = true;
+        }
+        e = slot;
+        ++e->refs;
+      }
+
+      // Join first, so a call that answers synchronously is not missed
+      auto mine = std::make_shared<subscription>(
+        e->subj.as_observable().subscribe(std::move(on_next), std::move(on_err), std::move(on_done)));
+      if (start) state::launch(st, key, e, make);
+
+      return subscription([st, key, e, mine]{
+        mine->reset();
+        subscription up;
+        {
+          std::lock_guard<std::mutex> lock(st->m);
+          if (--e->refs != 0 || e->finished) return;
+          e->finished = true;                 // abandoned: nobody is left to answer
+          st->evict(key, e);
+          up = std::move(e->upstream);
+        }
+        // `up` cancels the call on destruction
+      });
+    });
+  }
+
+  // Keys with a call in flight
+  std::size_t size() const {
+    std::lock_guard<std::mutex> lock(st_->m);
+    return st_->live.size();
+  }
+
+private:
+  struct entry {
+    explicit entry(std::size_t replay) : subj(replay) {}
+
+    replay_subject<U> subj;
+    subscription upstream;   // guarded by state::m
+    std::size_t refs{0};     // subscribers, guarded by state::m
+    bool finished{false};    // terminated or abandoned, guarded by state::m
+  };
+
+  struct state {
+    explicit state(std::size_t r) : replay(r) {}
+
+    const std::size_t replay;
+    std::mutex m;
+    std::unordered_map<K, std::shared_ptr<entry>, Hash, Eq> live;
+
+    // Under m: drops the key unless it already belongs to a newer call
+    void evict(const K& key, const std::shared_ptr<entry>& e) {
+      auto it = live.find(key);
+      if (it != live.end() && it->second == e) live.erase(it);
+    }
+
+    // The call terminated: evict it before the fan-out, so a subscriber that
+    // reacts to the answer starts a fresh call
+    bool finish(const K& key, const std::shared_ptr<entry>& e) {
+      subscription done;
+      {
+        std::lock_guard<std::mutex> lock(m);
+        if (e->finished) return false;
+        e->finished = true;
+        evict(key, e);
+        done = std::move(e->upstream);
+      }
+      done.release();
+      return true;
+    }
+
+    // Starts the call; strong captures: the cycles through e->upstream end
+    // with the call (finish() or abandonment moves the subscription out)
+    template <class Make>
+    static void launch(const std::shared_ptr<state>& st, const K& key,
+                       const std::shared_ptr<entry>& e, const Make& make) {
+      subscription up;
+      try {
+        up = make().subscribe(
+          [e](const U& v){ e->subj.on_next(v); },
+          [st, key, e](std::exception_ptr x){ if (st->finish(key, e)) e->subj.on_error(x); },
+          [st, key, e]{ if (st->finish(key, e)) e->subj.on_completed(); });
+      } catch (...) {
+        if (st->finish(key, e)) e->subj.on_error(std::current_exception());
+        return;
+      }
+      std::lock_guard<std::mutex> lock(st->m);
+      if (e->finished) {
+        up.release(); // terminated synchronously (the caller still holds its ref)
+        return;
+      }
+      e->upstream = std::move(up);
+    }
+  };
+
+  std::shared_ptr<state> st_;
+};
+
+// coalesce_by_key<T>(key_fn, f[, replay]): f (T -> observable<U>) wrapped so
+// that concurrent calls whose key_fn(v) compares equal share one inner
+// observable (see keyed_share). Use it wherever f was used, e.g.
+// switch_map(coalesce_by_key<std::string>(normalize, search)).
+template <class T, class KeyFn, class Fn>
+auto coalesce_by_key(KeyFn key_fn, Fn f, std::size_t replay = 1) {
+  using K = std::decay_t<std::invoke_result_t<const KeyFn&, const T&>>;
+  using U = typename std::decay_t<std::invoke_result_t<const Fn&, const T&>>::value_type;
+  return [share = keyed_share<K, U>(replay), key_fn = std::move(key_fn), f = std::move(f)](const T& v) {
+    return share.get(key_fn(v), [f, v]{ return f(v); });
+  };
+}
+
+} // namespace pulse
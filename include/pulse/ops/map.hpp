@@ -11,10 +11,10 @@ struct op_map {
   template <class T>
   auto operator()(const observable<T>& src) const {
     using U = std::invoke_result_t<F, const T&>;
-    return observable<U>::create([src, f = f](auto on_next, auto on_err, auto on_done){
+    return observable<U>::create_flow([src, f = f](auto on_next, auto on_err, auto on_done, auto d){
       return src.subscribe(
         [f, on_next](const T& v){ on_next(f(v)); },
-        on_err, on_done
+        on_err, on_done, d
       );
     });
   }
@@ -1,16 +1,24 @@
 #pragma once
 #include <pulse/core/observable.hpp>
 #include <pulse/core/subscription.hpp>
+#include <pulse/core/demand.hpp>
 #include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <utility>
+#include <vector>
 
 namespace pulse {
 
 // merge(a, b): Concurrent merge of two observable<T>
+// With flow control both sources draw from the same downstream credit.
 template <class T>
 inline observable<T> merge(const observable<T>& a, const observable<T>& b) {
-  return observable<T>::create([a, b](auto on_next, auto on_error, auto on_completed){
+  return observable<T>::create_flow([a, b](auto on_next, auto on_error, auto on_completed, auto d){
     struct state {
       std::atomic<bool> alive{true};        // is downstream alive
       std::atomic<bool> terminated{false};  // have on_error/on_completed already been sent
@@ -66,7 +74,8 @@ inline observable<T> merge(const observable<T>& a, const observable<T>& b) {
           s->remaining.fetch_sub(1);
           try_complete();
         }
-      }
+      },
+      d
     );
 
     // subscribe to B
@@ -95,7 +104,8 @@ inline observable<T> merge(const observable<T>& a, const observable<T>& b) {
           s->remaining.fetch_sub(1);
           try_complete();
         }
-      }
+      },
+      d
     );
 
     // unsubscribe downstream
@@ -108,13 +118,258 @@ inline observable<T> merge(const observable<T>& a, const observable<T>& b) {
   });
 }
 
-// merge(a, b, c, ...): variadic - reduce to paired merges
+// Tag: merge_all delivers one value per source in turn (see merge_all)
+struct round_robin_t {
+  explicit round_robin_t() = default;
+};
+inline constexpr round_robin_t round_robin{};
+
+namespace detail {
+
+// One state for all sources of a merge_all: a value costs one weak_ptr::lock()
+// whatever the number of sources
+template <class T>
+struct merge_all_state {
+  using OnNext = typename observable<T>::OnNext;
+  using OnErr  = typename observable<T>::OnErr;
+  using OnDone = typename observable<T>::OnDone;
+
+  OnNext on_next;
+  OnErr  on_err;
+  OnDone on_done;
+  std::atomic<bool> alive{true};        // is downstream alive
+  std::atomic<bool> terminated{false};  // have on_error/on_completed already been sent
+  std::atomic<std::size_t> remaining{0};// how many upstreams have not completed
+
+  std::mutex m;                         // ups
+  std::vector<subscription> ups;
+  bool cancelled{false};
+
+  void add(subscription s) {
+    {
+      std::lock_guard<std::mutex> lock(m);
+      if (!cancelled) { ups.push_back(std::move(s)); return; }
+    }
+    s.reset(); // already terminated while subscribing
+  }
+
+  void cancel_all() {
+    std::vector<subscription> tmp;
+    {
+      std::lock_guard<std::mutex> lock(m);
+      cancelled = true;
+      tmp.swap(ups);
+    }
+    tmp.clear();
+  }
+
+  bool try_terminate() {
+    bool expected = false;
+    if (!terminated.compare_exchange_strong(expected, true)) return false;
+    alive = false;
+    return true;
+  }
+};
+
+// round_robin: values wait in one lane per source and a single drain loop
+// delivers one value per ready lane in turn (serialized, O(1) per value). Each
+// source has its own credit: one value up front and one more whenever a value
+// leaves its lane, so a demand-aware source holds at most one value waiting.
+template <class T>
+struct merge_fair_state : merge_all_state<T> {
+  std::mutex qm;
+  std::vector<std::deque<T>> lanes;
+  std::vector<std::shared_ptr<demand>> lane_credit;
+  std::deque<std::size_t> ready;        // lanes with values, in turn order
+  std::exception_ptr error;
+  bool done_pending{false};
+  std::shared_ptr<demand> d;
+  demand::listener credit;
+  std::atomic<int> wip{0};
+
+  void push(std::size_t i, const T& v) {
+    {
+      std::lock_guard<std::mutex> lock(qm);
+      lanes[i].push_back(v);
+      if (lanes[i].size() == 1) ready.push_back(i);
+    }
+    drain();
+  }
+
+  void drain() {
+    if (wip.fetch_add(1, std::memory_order_acq_rel) != 0) return;
+    int missed = 1;
+    for (;;) {
+      for (;;) {
+        if (!this->alive) break;
+        std::optional<T> v;
+        std::size_t lane = 0;
+        std::exception_ptr err;
+        bool finish = false;
+        {
+          std::lock_guard<std::mutex> lock(qm);
+          if (error) {
+            err = error;
+          } else if (!ready.empty() && (!d || d->try_consume())) {
+            const std::size_t i = ready.front();
+            lane = i;
+            ready.pop_front();
+            v.emplace(std::move(lanes[i].front()));
+            lanes[i].pop_front();
+            if (!lanes[i].empty()) ready.push_back(i);
+          } else if (ready.empty() && done_pending) {
+            finish = true;
+          } else {
+            break;
+          }
+        }
+        if (v) {
+          lane_credit[lane]->request(1); // room in its lane again
+          if (this->on_next) this->on_next(*v);
+          continue;
+        }
+        if (!this->try_terminate()) break;
+        this->cancel_all();
+        if (err) { if (this->on_err) this->on_err(err); }
+        else if (finish && this->on_done) this->on_done();
+        break;
+      }
+      missed = wip.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+      if (missed == 0) break;
+    }
+  }
+};
+
+} // namespace detail
+
+// merge_all(sources): concurrent merge of a runtime collection of observable<T>.
+// All sources share one state and one completion counter, so a value costs the
+// same with 2 or 5000 sources. Completes when every source has completed (at
+// once for an empty collection); the first error cancels the rest. Values are
+// forwarded on the emitting thread, as with merge(a, b). With flow control every
+// source draws from the same downstream credit.
+template <class T>
+inline observable<T> merge_all(std::vector<observable<T>> sources) {
+  return observable<T>::create_flow([sources = std::move(sources)](auto on_next, auto on_error,
+                                                                   auto on_completed, auto d){
+    auto st = std::make_shared<detail::merge_all_state<T>>();
+    st->on_next = std::move(on_next);
+    st->on_err  = std::move(on_error);
+    st->on_done = std::move(on_completed);
+    st->remaining = sources.size();
+    if (sources.empty()) {
+      if (st->try_terminate() && st->on_done) st->on_done();
+      return subscription{};
+    }
+    std::weak_ptr<detail::merge_all_state<T>> wst = st;
+
+    st->ups.reserve(sources.size());
+    for (auto& src : sources) {
+      if (!st->alive) break;
+      st->add(src.subscribe(
+        [wst](const T& v){
+          if (auto s = wst.lock()) {
+            if (s->alive && s->on_next) s->on_next(v);
+          }
+        },
+        [wst](std::exception_ptr e){
+          if (auto s = wst.lock()) {
+            if (!s->try_terminate()) return;
+            s->cancel_all();
+            if (s->on_err) s->on_err(e);
+          }
+        },
+        [wst]{
+          if (auto s = wst.lock()) {
+            if (s->remaining.fetch_sub(1) != 1 || !s->try_terminate()) return;
+            s->cancel_all();
+            if (s->on_done) s->on_done();
+          }
+        },
+        d));
+    }
+
+    return subscription([st]{
+      st->alive = false;
+      st->cancel_all();
+    });
+  });
+}
+
+// merge_all(sources, round_robin): fair variant. Values wait in one lane per
+// source and are delivered serialized, one per ready source in turn, so a chatty
+// source cannot starve the others while downstream is busy. Errors are
+// delivered at once (queued values are dropped), completion after the lanes
+// are drained. With flow control the lanes are drained only as credit allows.
+// Every source is pulled one value at a time as its lane empties, so a slow
+// downstream keeps at most one value per demand-aware source waiting; sources
+// without flow control (observable::create) fill their lane without limit.
+template <class T>
+inline observable<T> merge_all(std::vector<observable<T>> sources, round_robin_t) {
+  return observable<T>::create_flow([sources = std::move(sources)](auto on_next, auto on_error,
+                                                                   auto on_completed, auto d){
+    auto st = std::make_shared<detail::merge_fair_state<T>>();
+    st->on_next = std::move(on_next);
+    st->on_err  = std::move(on_error);
+    st->on_done = std::move(on_completed);
+    st->remaining = sources.size();
+    st->lanes.resize(sources.size());
+    st->lane_credit.reserve(sources.size());
+    for (std::size_t i = 0; i < sources.size(); ++i)
+      st->lane_credit.push_back(std::make_shared<demand>());
+    st->d = d;
+    if (sources.empty()) {
+      if (st->try_terminate() && st->on_done) st->on_done();
+      return subscription{};
+    }
+    std::weak_ptr<detail::merge_fair_state<T>> wst = st;
+    if (d) st->credit = d->on_request([wst](std::size_t){ if (auto s = wst.lock()) s->drain(); });
+
+    st->ups.reserve(sources.size());
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+      if (!st->alive) break;
+      st->add(sources[i].subscribe(
+        [wst, i](const T& v){
+          if (auto s = wst.lock()) if (s->alive) s->push(i, v);
+        },
+        [wst](std::exception_ptr e){
+          if (auto s = wst.lock()) {
+            {
+              std::lock_guard<std::mutex> lock(s->qm);
+              if (!s->error) s->error = e;
+            }
+            s->drain();
+          }
+        },
+        [wst]{
+          if (auto s = wst.lock()) {
+            if (s->remaining.fetch_sub(1) != 1) return;
+            {
+              std::lock_guard<std::mutex> lock(s->qm);
+              s->done_pending = true;
+            }
+            s->drain();
+          }
+        },
+        st->lane_credit[i]));
+      st->lane_credit[i]->request(1);
+    }
+
+    return subscription([st]{
+      st->alive = false;
+      st->cancel_all();
+      if (st->d && st->credit) st->d->remove(st->credit);
+    });
+  });
+}
+
+// merge(a, b, c, ...): variadic - one flat merge_all over all sources
 template <class T, class... Rest>
 inline observable<T> merge(const observable<T>& a, const observable<T>& b, const Rest&... rest) {
   if constexpr (sizeof...(rest) == 0) {
     return merge<T>(a, b);
   } else {
-    return merge<T>(merge<T>(a, b), rest...);
+    return merge_all<T>(std::vector<observable<T>>{a, b, rest...});
   }
 }
 
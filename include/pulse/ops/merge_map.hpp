@@ -0,0 +1,234 @@
+#pragma once
+#include <pulse/core/observable.hpp>
+#include <pulse/core/subscription.hpp>
+#include <pulse/core/demand.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace pulse {
+
+// merge_map(f, k): maps every outer value to an inner observable and runs up to
+// k of them at once; further outer values wait until an inner one completes.
+// The outer source is asked for k values up front and for one more per finished
+// inner observable, so demand-aware sources (from_range, subject, ...) keep the
+// waiting queue at most k deep. Errors (outer, inner or thrown by f) cancel
+// everything; completion follows the outer completion and the last inner one.
+// As with merge, values are forwarded on the thread of the inner observable that
+// emitted them; inner observables share the downstream demand.
+// flat_map(f) is merge_map without a limit.
+template <class Fn>
+struct op_merge_map {
+  Fn fn;
+  std::size_t max_concurrent;
+
+  template <class T>
+  auto operator()(const observable<T>& src) const {
+    using inner_observable = decltype(fn(std::declval<T>()));
+    using U = typename inner_observable::value_type;
+
+    return observable<U>::create_flow([src, fn = fn, k = max_concurrent](auto on_next, auto on_error,
+                                                                         auto on_completed,
+                                                                         std::shared_ptr<demand> d) {
+      struct state : std::enable_shared_from_this<state> {
+        state(Fn f, std::size_t limit) : fn(std::move(f)), k(limit ? limit : 1) {}
+
+        Fn fn;
+        std::size_t k;
+        typename observable<U>::OnNext on_next;
+        typename observable<U>::OnErr  on_err;
+        typename observable<U>::OnDone on_done;
+        std::shared_ptr<demand> down;                       // downstream credit, shared by inners
+        std::shared_ptr<demand> outer = std::make_shared<demand>();
+
+        std::atomic<bool> alive{true};
+        std::mutex m;
+        std::deque<T> pending;                              // outer values waiting for a slot
+        std::size_t active{0};
+        bool outer_completed{false};
+        std::uint64_t next_id{0};
+        std::unordered_map<std::uint64_t, subscription> inners;
+        subscription sub_up;                                // guarded by m
+        std::atomic<int> wip{0};
+
+        // Starts inner observables while there are free slots (no recursion for
+        // inner observables that complete synchronously)
+        void launch() {
+          if (wip.fetch_add(1, std::memory_order_acq_rel) != 0) return;
+          int missed = 1;
+          for (;;) {
+            for (;;) {
+              std::optional<T> v;
+              {
+                std::lock_guard<std::mutex> lock(m);
+                if (!alive || active >= k || pending.empty()) break;
+                v.emplace(std::move(pending.front()));
+                pending.pop_front();
+                ++active;
+              }
+              start(*v);
+            }
+            missed = wip.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+            if (missed == 0) break;
+          }
+          try_complete();
+        }
+
+        void start(const T& v) {
+          std::optional<inner_observable> inner;
+          try {
+            inner.emplace(fn(v));
+          } catch (...) {
+            fail(std::current_exception());
+            return;
+          }
+          std::uint64_t id;
+          {
+            std::lock_guard<std::mutex> lock(m);
+            id = next_id++;
+            inners.emplace(id, subscription{});
+          }
+          std::weak_ptr<state> w = this->shared_from_this();
+          auto sub = inner->subscribe(
+            [w](const U& x){
+              if (auto s = w.lock(); s && s->alive && s->on_next) s->on_next(x);
+            },
+            [w](std::exception_ptr e){ if (auto s = w.lock()) s->fail(e); },
+            [w, id]{ if (auto s = w.lock()) s->inner_done(id); },
+            down);
+
+          std::lock_guard<std::mutex> lock(m);
+          auto it = inners.find(id);
+          if (it != inners.end()) it->second = std::move(sub);
+          else if (alive) sub.release(); // completed synchronously
+          // else: cancelled meanwhile, `sub` cancels on destruction
+        }
+
+        void inner_done(std::uint64_t id) {
+          subscription finished;
+          {
+            std::lock_guard<std::mutex> lock(m);
+            if (!alive) return;
+            auto it = inners.find(id);
+            if (it == inners.end()) return;
+            finished = std::move(it->second);
+            inners.erase(it);
+            --active;
+          }
+          finished.release(); // the source is done; its cancel is a no-op at best
+          if (!outer_done()) outer->request(1);
+          launch();
+        }
+
+        bool outer_done() {
+          std::lock_guard<std::mutex> lock(m);
+          return outer_completed;
+        }
+
+        void try_complete() {
+          subscription up;
+          {
+            std::lock_guard<std::mutex> lock(m);
+            if (!alive || !outer_completed || active != 0 || !pending.empty()) return;
+            alive = false;
+            up = std::move(sub_up);
+          }
+          up.release();
+          if (on_done) on_done();
+        }
+
+        void fail(std::exception_ptr e) {
+          if (!cancel()) return;
+          if (on_err) on_err(e);
+        }
+
+        // Stops everything; false if already stopped
+        bool cancel() {
+          std::unordered_map<std::uint64_t, subscription> tmp;
+          subscription up;
+          {
+            std::lock_guard<std::mutex> lock(m);
+            if (!alive) return false;
+            alive = false;
+            pending.clear();
+            tmp.swap(inners);
+            up = std::move(sub_up);
+          }
+          tmp.clear();
+          up.reset();
+          return true;
+        }
+
+        // Keeps the outer subscription unless everything stopped while
+        // subscribe() was still running (a synchronous outer, or inner ones
+        // finishing on other threads): then it is dropped right away
+        void store_up(subscription s) {
+          {
+            std::lock_guard<std::mutex> lock(m);
+            if (alive) { sub_up = std::move(s); return; }
+            if (!outer_completed) return; // cancelled: `s` cancels on destruction
+          }
+          s.release(); // the outer source is done
+        }
+      };
+
+      auto st = std::make_shared<state>(fn, k);
+      st->on_next = std::move(on_next);
+      st->on_err  = std::move(on_error);
+      st->on_done = std::move(on_completed);
+      st->down = std::move(d);
+      std::weak_ptr<state> wst = st;
+
+      auto up = src.subscribe(
+        [wst](const T& v){
+          auto s = wst.lock();
+          if (!s) return;
+          {
+            std::lock_guard<std::mutex> lock(s->m);
+            if (!s->alive) return;
+            s->pending.push_back(v);
+          }
+          s->launch();
+        },
+        [wst](std::exception_ptr e){ if (auto s = wst.lock()) s->fail(e); },
+        [wst]{
+          auto s = wst.lock();
+          if (!s) return;
+          {
+            std::lock_guard<std::mutex> lock(s->m);
+            s->outer_completed = true;
+          }
+          s->try_complete();
+        },
+        st->outer);
+      st->store_up(std::move(up));
+      st->outer->request(st->k == std::numeric_limits<std::size_t>::max() ? demand::unbounded : st->k);
+
+      return subscription([st]{ st->cancel(); });
+    });
+  }
+};
+
+template <class Fn>
+inline auto merge_map(Fn fn, std::size_t max_concurrent) {
+  return op_merge_map<std::decay_t<Fn>>{ std::forward<Fn>(fn), max_concurrent };
+}
+
+template <class Fn>
+inline auto flat_map(Fn fn) {
+  return op_merge_map<std::decay_t<Fn>>{ std::forward<Fn>(fn), std::numeric_limits<std::size_t>::max() };
+}
+
+} // namespace pulse
@@ -2,6 +2,10 @@
 #include <pulse/core/observable.hpp>
 #include <pulse/core/scheduler.hpp>
 #include <pulse/core/subscription.hpp>
+#include <pulse/core/mpsc_queue.hpp>
+#include <cstddef>
+#include <exception>
+#include <optional>
 #include <memory>
 #include <functional>
 #include <atomic>
@@ -9,53 +13,183 @@
 
 namespace pulse {
 
+namespace detail {
+
+// Shared body of observe_on(executor&) and observe_on(shared_ptr<executor>).
+// Exec is anything dereferenceable to executor (raw or shared pointer).
+// With inline_current the value is delivered directly when the upstream already
+// emits on a thread of ex and nothing of this subscription is queued or being
+// delivered (otherwise the order of events would change); see
+// detail::inline_serializer - deliveries never overlap, even when several
+// workers of a pool emit at once.
+template <class T, class Exec, class OnNext, class OnErr, class OnDone>
+subscription observe_on_subscribe(const observable<T>& src, Exec ex, bool inline_current,
+                                  OnNext on_next, OnErr on_err, OnDone on_done,
+                                  std::shared_ptr<demand> d = nullptr) {
+  struct state {
+    // all tasks of this subscription: reset() drops the ones still queued
+    std::shared_ptr<cancel_group> group = std::make_shared<cancel_group>();
+    std::shared_ptr<inline_serializer> serial = std::make_shared<inline_serializer>();
+  };
+  auto st = std::make_shared<state>();
+
+  // Runs `deliver` inline if allowed, otherwise posts it to ex
+  auto dispatch = [ex, inline_current, st](auto deliver) {
+    if (st->group->cancelled()) return;
+    if (!inline_current) {
+      ex->post([st, deliver = std::move(deliver)]{
+        if (st->group->cancelled()) return;
+        deliver();
+      }, st->group);
+      return;
+    }
+    st->serial->run(*ex, std::move(deliver), st->group);
+  };
+
+  auto up = src.subscribe(
+    [dispatch, on_next](const T& v){
+      dispatch([on_next, v]{ if (on_next) on_next(v); });
+    },
+    [dispatch, on_err](std::exception_ptr e){
+      dispatch([on_err, e]{ if (on_err) on_err(e); });
+    },
+    [dispatch, on_done]{
+      dispatch([on_done]{ if (on_done) on_done(); });
+    },
+    std::move(d) // queued values never exceed the downstream credit
+  );
+
+  auto up_ptr = std::make_shared<subscription>(std::move(up));
+
+  return subscription([st, up_ptr]() mutable {
+    st->group->cancel();
+    *up_ptr = subscription{};
+  });
+}
+
+// observe_on(ex, batched{budget}): events go into a per-subscription lock-free
+// queue and at most one drain task per subscription is scheduled on ex. The drain
+// task delivers up to `budget` events and re-posts itself if more are waiting, so
+// other work on ex is not starved. Terminal events travel through the same queue,
+// so on_error/on_completed are never delivered before the values preceding them.
+template <class T, class Exec, class OnNext, class OnErr, class OnDone>
+subscription observe_on_batched_subscribe(const observable<T>& src, Exec ex, std::size_t budget,
+                                          OnNext on_next, OnErr on_err, OnDone on_done,
+                                          std::shared_ptr<demand> d = nullptr) {
+  struct event {
+    std::optional<T> value;  // empty for terminal events
+    std::exception_ptr error;
+  };
+  struct state {
+    std::shared_ptr<cancel_group> group = std::make_shared<cancel_group>();
+    mpsc_queue<event> q;
+    std::atomic<std::size_t> wip{0}; // events pushed and not yet consumed
+    bool terminated{false};          // drain side only
+    std::function<void()> drain;
+  };
+  if (budget == 0) budget = 1;
+  auto st = std::make_shared<state>();
+  std::weak_ptr<state> wst = st;
+
+  st->drain = [wst, ex, budget, on_next, on_err, on_done]{
+    auto s = wst.lock();
+    if (!s || s->group->cancelled()) return;
+    std::size_t missed = s->wip.load(std::memory_order_acquire);
+    std::size_t left = budget;
+    for (;;) {
+      std::size_t done = 0;
+      while (done < missed && left > 0) {
+        std::optional<event> ev = s->q.try_pop();
+        if (!ev) continue; // counted push is still linking its node
+        ++done;
+        --left;
+        if (s->terminated || s->group->cancelled()) continue;
+        if (ev->value) {
+          if (on_next) on_next(*ev->value);
+        } else {
+          s->terminated = true;
+          if (ev->error) { if (on_err) on_err(ev->error); }
+          else if (on_done) on_done();
+        }
+      }
+      missed = s->wip.fetch_sub(done, std::memory_order_acq_rel) - done;
+      if (missed == 0) return;
+      if (left == 0) {
+        // fairness budget spent - give the executor back and continue later
+        ex->post([s]{ s->drain(); }, s->group);
+        return;
+      }
+    }
+  };
+
+  auto push = [wst, ex](event ev){
+    auto s = wst.lock();
+    if (!s || s->group->cancelled()) return;
+    s->q.push(std::move(ev));
+    if (s->wip.fetch_add(1, std::memory_order_acq_rel) == 0)
+      ex->post([s]{ s->drain(); }, s->group);
+  };
+
+  auto up = src.subscribe(
+    [push](const T& v){ push(event{v, nullptr}); },
+    [push](std::exception_ptr e){ push(event{std::nullopt, e}); },
+    [push]{ push(event{std::nullopt, nullptr}); },
+    std::move(d)
+  );
+
+  auto up_ptr = std::make_shared<subscription>(std::move(up));
+
+  return subscription([st, up_ptr]() mutable {
+    st->group->cancel();
+    *up_ptr = subscription{};
+  });
+}
+
+} // namespace detail
+
+// Tag for the draining mode of observe_on (see detail::observe_on_batched_subscribe)
+struct batched {
+  std::size_t budget{256}; // max events per drain task before yielding the executor
+};
+
 // ----------------------------
 // observe_on(executor&)
 // IMPORTANT: ex must outlive the subscription!
 // ----------------------------
 struct op_observe_on {
   executor* ex;
+  bool inline_current{false};
 
   template <class T>
   auto operator()(const observable<T>& src) const {
-    return observable<T>::create([src, ex = ex](auto on_next, auto on_err, auto on_done) {
-      auto alive = std::make_shared<std::atomic<bool>>(true);
-
-      auto up = src.subscribe(
-        [ex, on_next, alive](const T& v){
-          if (!*alive) return;
-          ex->post([on_next, v, alive]{
-            if (!*alive) return;
-            if (on_next) on_next(v);
-          });
-        },
-        [ex, on_err, alive](std::exception_ptr e){
-          if (!*alive) return;
-          ex->post([on_err, e, alive]{
-            if (!*alive) return;
-            if (on_err) on_err(e);
-          });
-        },
-        [ex, on_done, alive]{
-          if (!*alive) return;
-          ex->post([on_done, alive]{
-            if (!*alive) return;
-            if (on_done) on_done();
-          });
-        }
-      );
+    return observable<T>::create_flow([src, ex = ex, inl = inline_current](auto on_next, auto on_err, auto on_done, auto d) {
+      return detail::observe_on_subscribe(src, ex, inl, std::move(on_next), std::move(on_err), std::move(on_done), std::move(d));
+    });
+  }
+};
 
-      auto up_ptr = std::make_shared<subscription>(std::move(up));
+inline auto observe_on(executor& ex){ return op_observe_on{ &ex }; }
 
-      return subscription([alive, up_ptr]() mutable {
-        *alive = false;
-        *up_ptr = subscription{};
-      });
+// observe_on(ex, inline_if_current): skip the queue round trip when the upstream
+// already emits on a thread of ex (e.g. one pool stage feeding another on the same pool)
+inline auto observe_on(executor& ex, inline_if_current_t){ return op_observe_on{ &ex, true }; }
+
+// Exec: executor* or std::shared_ptr<executor>
+template <class Exec>
+struct op_observe_on_batched {
+  Exec ex;
+  std::size_t budget;
+
+  template <class T>
+  auto operator()(const observable<T>& src) const {
+    return observable<T>::create_flow([src, ex = ex, budget = budget](auto on_next, auto on_err, auto on_done, auto d) {
+      return detail::observe_on_batched_subscribe(src, ex, budget, std::move(on_next), std::move(on_err), std::move(on_done), std::move(d));
     });
   }
 };
 
-inline auto observe_on(executor& ex){ return op_observe_on{ &ex }; }
+// observe_on(ex, batched{}): one drain task per burst instead of one task per event
+inline auto observe_on(executor& ex, batched b){ return op_observe_on_batched<executor*>{ &ex, b.budget }; }
 
 // ----------------------------
 // observe_on(shared_ptr<executor>)
@@ -63,43 +197,13 @@ inline auto observe_on(executor& ex){ return op_observe_on{ &ex }; }
 // ----------------------------
 struct op_observe_on_sp {
   std::shared_ptr<executor> ex;
+  bool inline_current{false};
 
   template <class T>
   auto operator()(const observable<T>& src) const {
     auto exec = ex;
-    return observable<T>::create([src, exec](auto on_next, auto on_err, auto on_done) {
-      auto alive = std::make_shared<std::atomic<bool>>(true);
-
-      auto up = src.subscribe(
-        [exec, on_next, alive](const T& v){
-          if (!*alive) return;
-          exec->post([on_next, v, alive]{
-            if (!*alive) return;
-            if (on_next) on_next(v);
-          });
-        },
-        [exec, on_err, alive](std::exception_ptr e){
-          if (!*alive) return;
-          exec->post([on_err, e, alive]{
-            if (!*alive) return;
-            if (on_err) on_err(e);
-          });
-        },
-        [exec, on_done, alive]{
-          if (!*alive) return;
-          exec->post([on_done, alive]{
-            if (!*alive) return;
-            if (on_done) on_done();
-          });
-        }
-      );
-
-      auto up_ptr = std::make_shared<subscription>(std::move(up));
-
-      return subscription([alive, up_ptr]() mutable {
-        *alive = false;
-        *up_ptr = subscription{};
-      });
+    return observable<T>::create_flow([src, exec, inl = inline_current](auto on_next, auto on_err, auto on_done, auto d) {
+      return detail::observe_on_subscribe(src, exec, inl, std::move(on_next), std::move(on_err), std::move(on_done), std::move(d));
     });
   }
 };
@@ -108,4 +212,12 @@ inline auto observe_on(std::shared_ptr<executor> ex){
   return op_observe_on_sp{ std::move(ex) };
 }
 
+inline auto observe_on(std::shared_ptr<executor> ex, inline_if_current_t){
+  return op_observe_on_sp{ std::move(ex), true };
+}
+
+inline auto observe_on(std::shared_ptr<executor> ex, batched b){
+  return op_observe_on_batched<std::shared_ptr<executor>>{ std::move(ex), b.budget };
+}
+
 } // namespace pulse
@@ -0,0 +1,309 @@
+#pragma once
+#include <pulse/core/observable.hpp>
+#include <pulse/core/scheduler.hpp>
+#include <pulse/core/cancel_group.hpp>
+#include <pulse/core/subscription.hpp>
+#include <pulse/core/demand.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pulse {
+
+struct parallel_map_options {
+  bool ordered{true};            // emit in input order (reorder ring) or as soon as ready
+  std::size_t max_in_flight{64}; // values handed to f and not yet emitted downstream
+};
+
+// parallel_map(ex, f, opts): runs f for every value as a task on ex (usually a
+// thread_pool). Every value gets a sequence number; in ordered mode finished
+// results wait in a ring of max_in_flight slots until all earlier ones were
+// emitted, so the output order equals the input order. Unordered mode emits
+// each result as soon as it is ready.
+//
+// At most max_in_flight values are in flight: the upstream is asked for one
+// more value per emitted result (and only while there is downstream credit);
+// values from sources that ignore demand wait in a queue. Emission is
+// serialized and runs on the thread that completed the result (usually a pool
+// thread) - add observe_on to move it elsewhere. f throwing is an error at the
+// position of its value; upstream errors and completion are delivered after
+// every result still in flight.
+// IMPORTANT: ex must outlive the subscription!
+template <class Fn>
+struct op_parallel_map {
+  executor* ex;
+  Fn fn;
+  parallel_map_options opts;
+
+  template <class T>
+  auto operator()(const observable<T>& src) const {
+    using U = std::decay_t<std::invoke_result_t<const Fn&, const T&>>;
+
+    return observable<U>::create_flow([src, ex = ex, fn = fn, opts = opts](auto on_next, auto on_error,
+                                                                           auto on_completed,
+                                                                           std::shared_ptr<demand> d) {
+      struct result {
+        std::optional<U> value;
+        std::exception_ptr error;
+      };
+
+      struct state : std::enable_shared_from_this<state> {
+        state(executor* e, Fn f, parallel_map_options o)
+          : ex(e), fn(std::move(f)), ordered(o.ordered),
+            window(o.max_in_flight ? o.max_in_flight : 1) {
+          if (ordered) {
+            ring.resize(window);
+            filled.assign(window, false);
+          }
+        }
+
+        executor* ex;
+        Fn fn;
+        const bool ordered;
+        const std::size_t window;
+        typename observable<U>::OnNext on_next;
+        typename observable<U>::OnErr  on_err;
+        typename observable<U>::OnDone on_done;
+        std::shared_ptr<cancel_group> group = std::make_shared<cancel_group>();
+        std::shared_ptr<demand> down;
+        demand::listener down_listener;
+        std::shared_ptr<demand> outer = std::make_shared<demand>();
+
+        std::mutex m;
+        bool alive{true};
+        std::size_t credit{0};             // downstream credit not yet passed upstream
+        std::size_t requested{0};          // upstream values requested and not yet received
+        std::size_t in_flight{0};          // running or waiting in ring/ready
+        std::uint64_t next_seq{0};
+        std::uint64_t next_emit{0};        // ordered: sequence number the ring waits for
+        std::vector<result> ring;          // ordered: slot seq % window
+        std::vector<bool> filled;
+        std::deque<result> ready;          // unordered
+        std::deque<T> pending;             // received while the window was full
+        bool upstream_done{false};
+        std::exception_ptr upstream_error;
+        subscription sub_up;               // guarded by m
+        std::atomic<int> wip{0};
+
+        // Downstream granted n more values
+        void grant(std::size_t n) {
+          {
+            std::lock_guard<std::mutex> lock(m);
+            credit = (credit > demand::unbounded - n) ? demand::unbounded : credit + n;
+          }
+          pump();
+        }
+
+        // Passes credit upstream while the window has room
+        void pump() {
+          std::size_t n = 0;
+          {
+            std::lock_guard<std::mutex> lock(m);
+            if (!alive) return;
+            while (credit > 0 && in_flight + pending.size() + requested + n < window) {
+              if (credit != demand::unbounded) --credit;
+              ++n;
+            }
+            requested += n;
+          }
+          if (n) outer->request(n);
+        }
+
+        void receive(const T& v) {
+          std::uint64_t seq;
+          {
+            std::lock_guard<std::mutex> lock(m);
+            if (!alive) return;
+            if (requested) --requested;
+            if (in_flight >= window || !pending.empty()) {
+              pending.push_back(v);
+              return;
+            }
+            ++in_flight;
+            seq = next_seq++;
+          }
+          submit(v, seq);
+        }
+
+        void submit(T v, std::uint64_t seq) {
+          std::weak_ptr<state> w = this->shared_from_this();
+          ex->post([w, v = std::move(v), seq]{
+            auto s = w.lock();
+            if (!s) return;
+            result r;
+            try {
+              r.value.emplace(s->fn(v));
+            } catch (...) {
+              r.error = std::current_exception();
+            }
+            s->finish(seq, std::move(r));
+          }, group);
+        }
+
+        void finish(std::uint64_t seq, result r) {
+          {
+            std::lock_guard<std::mutex> lock(m);
+            if (!alive) return;
+            if (ordered) {
+              ring[seq % window] = std::move(r);
+              filled[seq % window] = true;
+            } else {
+              ready.push_back(std::move(r));
+            }
+          }
+          drain();
+        }
+
+        // Next result that may be emitted, if any (under m)
+        std::optional<result> take_ready() {
+          if (ordered) {
+            const std::size_t i = next_emit % window;
+            if (!filled[i]) return std::nullopt;
+            filled[i] = false;
+            ++next_emit;
+            return std::move(ring[i]);
+          }
+          if (ready.empty()) return std::nullopt;
+          result r = std::move(ready.front());
+          ready.pop_front();
+          return r;
+        }
+
+        // Serialized emission (wip/missed): results, queued inputs, terminal events
+        void drain() {
+          if (wip.fetch_add(1, std::memory_order_acq_rel) != 0) return;
+          int missed = 1;
+          for (;;) {
+            for (;;) {
+              std::optional<result> r;
+              std::optional<T> next_in;
+              std::uint64_t seq = 0;
+              bool finished = false;
+              std::exception_ptr up_err;
+              subscription up;
+              {
+                std::lock_guard<std::mutex> lock(m);
+                if (!alive) return;
+                r = take_ready();
+                if (r) {
+                  --in_flight;
+                  if (!pending.empty()) {
+                    next_in.emplace(std::move(pending.front()));
+                    pending.pop_front();
+                    ++in_flight;
+                    seq = next_seq++;
+                  }
+                } else if (upstream_done && in_flight == 0 && pending.empty()) {
+                  alive = false;
+                  finished = true;
+                  up_err = upstream_error;
+                  up = std::move(sub_up);
+                }
+              }
+              if (finished) {
+                if (down && down_listener) down->remove(down_listener);
+                up.release();
+                if (up_err) { if (on_err) on_err(up_err); }
+                else if (on_done) on_done();
+                return;
+              }
+              if (!r) break;
+              if (next_in) submit(std::move(*next_in), seq);
+              if (r->error) {
+                fail(r->error);
+                return;
+              }
+              if (on_next) on_next(*r->value);
+              pump();
+            }
+            missed = wip.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+            if (missed == 0) break;
+          }
+        }
+
+        void upstream_terminated(std::exception_ptr e) {
+          {
+            std::lock_guard<std::mutex> lock(m);
+            if (!alive) return;
+            upstream_done = true;
+            upstream_error = e;
+          }
+          drain();
+        }
+
+        void fail(std::exception_ptr e) {
+          if (!cancel()) return;
+          if (on_err) on_err(e);
+        }
+
+        // Stops everything; false if already stopped
+        bool cancel() {
+          subscription up;
+          {
+            std::lock_guard<std::mutex> lock(m);
+            if (!alive) return false;
+            alive = false;
+            pending.clear();
+            ready.clear();
+            up = std::move(sub_up);
+          }
+          group->cancel();
+          if (down && down_listener) down->remove(down_listener);
+          up.reset();
+          return true;
+        }
+
+        // Keeps the upstream subscription unless everything stopped while
+        // subscribe() was still running: then it is dropped right away
+        void store_up(subscription s) {
+          {
+            std::lock_guard<std::mutex> lock(m);
+            if (alive) { sub_up = std::move(s); return; }
+            if (!upstream_done) return; // cancelled: `s` cancels on destruction
+          }
+          s.release(); // the source is done
+        }
+      };
+
+      auto st = std::make_shared<state>(ex, fn, opts);
+      st->on_next = std::move(on_next);
+      st->on_err  = std::move(on_error);
+      st->on_done = std::move(on_completed);
+      std::weak_ptr<state> wst = st;
+
+      auto up = src.subscribe(
+        [wst](const T& v){ if (auto s = wst.lock()) s->receive(v); },
+        [wst](std::exception_ptr e){ if (auto s = wst.lock()) s->upstream_terminated(e); },
+        [wst]{ if (auto s = wst.lock()) s->upstream_terminated(nullptr); },
+        st->outer);
+      st->store_up(std::move(up));
+
+      if (d) {
+        st->down = std::move(d);
+        st->down_listener = forward_demand(st->down, [wst](std::size_t n){
+          if (auto s = wst.lock()) s->grant(n);
+        });
+      } else {
+        st->grant(demand::unbounded);
+      }
+
+      return subscription([st]{ st->cancel(); });
+    });
+  }
+};
+
+template <class Fn>
+inline auto parallel_map(executor& ex, Fn fn, parallel_map_options opts = {}) {
+  return op_parallel_map<std::decay_t<Fn>>{ &ex, std::forward<Fn>(fn), opts };
+}
+
+} // namespace pulse
@@ -1,10 +1,10 @@
 #pragma once
 #include <pulse/core/observable.hpp>
 #include <pulse/core/subscription.hpp>
+#include <pulse/core/multicast_hub.hpp>
 #include <mutex>
 #include <vector>
 #include <memory>
-#include <algorithm>
 #include <stdexcept>
 #include <chrono>
 #include <thread>
@@ -25,18 +25,8 @@ public:
   observable<T> as_observable() const {
     auto hub = hub_;
     return observable<T>::create([hub](OnNext on_next, OnErr on_err, OnDone on_done){
-      std::size_t idx = 0;
-      {
-        std::lock_guard<std::mutex> lock(hub->m);
-        idx = hub->next_id++;
-        hub->subs.push_back({idx, std::move(on_next), std::move(on_err), std::move(on_done)});
-      }
-      return subscription([hub, idx]{
-        std::lock_guard<std::mutex> lock(hub->m);
-        auto& v = hub->subs;
-        v.erase(std::remove_if(v.begin(), v.end(),
-                  [idx](const slot& s){ return s.id == idx; }), v.end());
-      });
+      auto h = hub->subs.add(std::move(on_next), std::move(on_err), std::move(on_done));
+      return subscription([hub, h]{ hub->subs.remove(h); });
     });
   }
 
@@ -58,36 +48,20 @@ public:
     }
 
     hub_->upstream = src_.subscribe(
-      [h = hub_](const T& v){
-        std::vector<OnNext> local;
-        {
-          std::lock_guard<std::mutex> lock(h->m);
-          local.reserve(h->subs.size());
-          for (auto& s : h->subs) local.push_back(s.on_next);
-        }
-        for (auto& f : local) if (f) f(v);
-      },
+      [h = hub_](const T& v){ h->subs.on_next(v); },
       [h = hub_](std::exception_ptr e){
-        std::vector<OnErr> local;
         {
           std::lock_guard<std::mutex> lock(h->m);
           h->errored = true; h->err_ptr = e;
-          local.reserve(h->subs.size());
-          for (auto& s : h->subs) local.push_back(s.on_err);
-          h->subs.clear();
         }
-        for (auto& f : local) if (f) f(e);
+        h->subs.on_error(e);
       },
       [h = hub_]{
-        std::vector<OnDone> local;
         {
           std::lock_guard<std::mutex> lock(h->m);
           h->completed = true;
-          local.reserve(h->subs.size());
-          for (auto& s : h->subs) local.push_back(s.on_done);
-          h->subs.clear();
         }
-        for (auto& f : local) if (f) f();
+        h->subs.on_completed();
       }
     );
 
@@ -109,21 +83,14 @@ public:
   }
 
 private:
-  struct slot {
-    std::size_t id;
-    OnNext on_next;
-    OnErr  on_err;
-    OnDone on_done;
-  };
   struct hub_t {
-    std::mutex m;
-    std::vector<slot> subs;
+    std::mutex m;          // connection state; fan-out does not take it
+    multicast_hub<T> subs;
     subscription upstream;
     bool started{false};
     bool completed{false};
     bool errored{false};
     std::exception_ptr err_ptr{};
-    std::size_t next_id{0};
   };
 
   observable<T> src_;
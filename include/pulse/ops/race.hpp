@@ -0,0 +1,365 @@
+#pragma once
+#include <pulse/core/observable.hpp>
+#include <pulse/core/subscription.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pulse {
+
+namespace detail {
+
+inline constexpr std::size_t no_winner = std::numeric_limits<std::size_t>::max();
+
+template <class U> struct hedge_state;
+
+// Subscriptions of the contenders of race()/hedge(). The first contender to
+// claim() wins; the others are cancelled (outside the lock) as soon as they are
+// known, including ones whose subscribe() returns after the race was decided.
+class race_slots {
+public:
+  // True if contender i won (now or earlier); *losers: contenders cancelled now
+  bool claim(std::size_t i, std::size_t* losers = nullptr) {
+    std::size_t w = winner_.load(std::memory_order_acquire);
+    if (w != no_winner) return w == i;
+    if (!winner_.compare_exchange_strong(w, i, std::memory_order_acq_rel)) return w == i;
+    std::vector<subscription> drop;
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      for (std::size_t k = 0; k < slots_.size(); ++k) {
+        if (k == i || slots_[k].state != live) continue;
+        slots_[k].state = lost;
+        drop.push_back(std::move(slots_[k].sub));
+      }
+    }
+    if (losers) *losers = drop.size();
+    drop.clear();
+    return true;
+  }
+
+  bool decided() const noexcept { return winner_.load(std::memory_order_acquire) != no_winner; }
+  std::size_t winner() const noexcept { return winner_.load(std::memory_order_acquire); }
+
+  // Registers contender i before it is subscribed
+  void open(std::size_t i) {
+    std::lock_guard<std::mutex> lock(m_);
+    if (slots_.size() <= i) slots_.resize(i + 1);
+    if (slots_[i].state == idle) slots_[i].state = stopped_ ? lost : live;
+  }
+
+  // Keeps the subscription of contender i while it may still deliver
+  void store(std::size_t i, subscription s) {
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      const std::size_t w = winner_.load(std::memory_order_acquire);
+      if (slots_[i].state == live && (w == no_winner || w == i)) {
+        slots_[i].sub = std::move(s);
+        return;
+      }
+      if (slots_[i].state == done) {
+        s.release(); // terminated synchronously: nothing to cancel
+        return;
+      }
+    }
+    // lost meanwhile: `s` cancels on destruction
+  }
+
+  // Contender i terminated on its own: forget its subscription without cancelling
+  void finished(std::size_t i) {
+    subscription gone;
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      if (i >= slots_.size() || slots_[i].state != live) return;
+      slots_[i].state = done;
+      gone = std::move(slots_[i].sub);
+    }
+    gone.release();
+  }
+
+  // Cancels every contender (downstream unsubscribed)
+  void stop() {
+    std::vector<subscription> drop;
+    {
+      std::lock_guard<std::mutex> lock(m_);
+      stopped_ = true;
+      for (auto& sl : slots_) {
+        if (sl.state != live) continue;
+        sl.state = lost;
+        drop.push_back(std::move(sl.sub));
+      }
+    }
+    drop.clear();
+  }
+
+private:
+  enum slot_state : unsigned char { idle, live, done, lost };
+  struct slot {
+    slot_state state{idle};
+    subscription sub;
+  };
+
+  std::atomic<std::size_t> winner_{no_winner};
+  std::mutex m_;
+  std::vector<slot> slots_;
+  bool stopped_{false};
+};
+
+} // namespace detail
+
+// race(o1, o2, ...): mirrors the first source to emit anything (a value, an
+// error or completion) and cancels all the others at that moment. Sources are
+// subscribed in order; one that wins synchronously keeps the later ones from
+// being subscribed at all.
+template <class T>
+observable<T> race(std::vector<observable<T>> sources) {
+  return observable<T>::create([sources = std::move(sources)](auto on_next, auto on_err, auto on_done){
+    auto slots = std::make_shared<detail::race_slots>();
+    for (std::size_t i = 0; i < sources.size() && !slots->decided(); ++i) {
+      slots->open(i);
+      std::weak_ptr<detail::race_slots> w = slots;
+      auto sub = sources[i].subscribe(
+        [w, i, on_next](const T& v){
+          if (auto s = w.lock(); s && s->claim(i) && on_next) on_next(v);
+        },
+        [w, i, on_err](std::exception_ptr e){
+          auto s = w.lock();
+          if (!s || !s->claim(i)) return;
+          s->finished(i);
+          if (on_err) on_err(e);
+        },
+        [w, i, on_done]{
+          auto s = w.lock();
+          if (!s || !s->claim(i)) return;
+          s->finished(i);
+          if (on_done) on_done();
+        });
+      slots->store(i, std::move(sub));
+    }
+    return subscription([slots]{ slots->stop(); });
+  });
+}
+
+template <class T, class... Ts>
+observable<T> race(const observable<T>& first, const observable<Ts>&... rest) {
+  static_assert((std::is_same_v<T, Ts> && ...), "race: all sources must have the same value type");
+  return race(std::vector<observable<T>>{ first, rest... });
+}
+
+// Counters of one hedge() call site (relaxed; readable from any thread)
+struct hedge_stats {
+  std::uint64_t calls{0};       // subscriptions
+  std::uint64_t hedged{0};      // calls that started at least one duplicate
+  std::uint64_t duplicates{0};  // duplicate attempts started
+  std::uint64_t hedge_wins{0};  // calls answered by a duplicate, not the first attempt
+  std::uint64_t cancelled{0};   // attempts cancelled because another one answered
+};
+
+class hedge_counters {
+public:
+  hedge_stats snapshot() const noexcept {
+    return hedge_stats{calls_.load(std::memory_order_relaxed),
+                       hedged_.load(std::memory_order_relaxed),
+                       duplicates_.load(std::memory_order_relaxed),
+                       hedge_wins_.load(std::memory_order_relaxed),
+                       cancelled_.load(std::memory_order_relaxed)};
+  }
+
+private:
+  template <class> friend struct detail::hedge_state;
+
+  std::atomic<std::uint64_t> calls_{0};
+  std::atomic<std::uint64_t> hedged_{0};
+  std::atomic<std::uint64_t> duplicates_{0};
+  std::atomic<std::uint64_t> hedge_wins_{0};
+  std::atomic<std::uint64_t> cancelled_{0};
+};
+
+namespace detail {
+
+// One subscription to hedge(f, ...): the attempts race for the first
+// notification; a timer thread starts the next attempt every `delay` until one
+// answers or max_attempts were started.
+template <class U>
+struct hedge_state : std::enable_shared_from_this<hedge_state<U>> {
+  using clock = std::chrono::steady_clock;
+
+  std::function<observable<U>()> make;
+  clock::duration delay;
+  std::size_t max_attempts;
+  std::shared_ptr<hedge_counters> stats;
+  typename observable<U>::OnNext on_next;
+  typename observable<U>::OnErr  on_err;
+  typename observable<U>::OnDone on_done;
+  race_slots slots;
+
+  std::mutex m;
+  std::condition_variable cv;
+  bool stopped{false};            // decided or cancelled: the timer exits
+  std::size_t started{0};
+  std::size_t failed{0};
+  clock::time_point last_start{};
+
+  // First attempt, then the timer if duplicates are still possible
+  void start() {
+    if (stats) stats->calls_.fetch_add(1, std::memory_order_relaxed);
+    launch();
+    if (max_attempts < 2) return;
+    {
+      std::lock_guard<std::mutex> lock(m);
+      if (stopped || started >= max_attempts) return;
+    }
+    std::thread([self = this->shared_from_this()]{ self->run_timer(); }).detach();
+  }
+
+  // Starts the next attempt (every one after the first is a duplicate); false
+  // if none was started
+  bool launch() {
+    std::size_t i;
+    {
+      std::lock_guard<std::mutex> lock(m);
+      if (stopped || slots.decided() || started >= max_attempts) return false;
+      i = started++;
+      last_start = clock::now();
+    }
+    cv.notify_all();
+    if (stats && i > 0) {
+      if (i == 1) stats->hedged_.fetch_add(1, std::memory_order_relaxed);
+      stats->duplicates_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    slots.open(i);
+    std::optional<observable<U>> o;
+    try {
+      o.emplace(make());
+    } catch (...) {
+      attempt_failed(i, std::current_exception());
+      return true;
+    }
+    std::weak_ptr<hedge_state> w = this->shared_from_this();
+    auto sub = o->subscribe(
+      [w, i](const U& v){
+        auto s = w.lock();
+        if (s && s->won(i) && s->on_next) s->on_next(v);
+      },
+      [w, i](std::exception_ptr e){
+        auto s = w.lock();
+        if (!s) return;
+        if (s->slots.winner() == i) {
+          s->slots.finished(i);
+          if (s->on_err) s->on_err(e);
+        } else if (!s->slots.decided()) {
+          s->attempt_failed(i, e);
+        }
+      },
+      [w, i]{
+        auto s = w.lock();
+        if (!s || !s->won(i)) return;
+        s->slots.finished(i);
+        if (s->on_done) s->on_done();
+      });
+    slots.store(i, std::move(sub));
+    return true;
+  }
+
+  bool won(std::size_t i) {
+    if (slots.winner() == i) return true;
+    std::size_t losers = 0;
+    if (!slots.claim(i, &losers)) return false;
+    halt();
+    if (stats) {
+      if (i > 0) stats->hedge_wins_.fetch_add(1, std::memory_order_relaxed);
+      if (losers) stats->cancelled_.fetch_add(losers, std::memory_order_relaxed);
+    }
+    return true;
+  }
+
+  // An attempt failed before any answer: try the next one right away; the error
+  // is delivered once every attempt has failed
+  void attempt_failed(std::size_t i, std::exception_ptr e) {
+    slots.finished(i);
+    {
+      std::lock_guard<std::mutex> lock(m);
+      if (stopped) return;
+      ++failed;
+    }
+    if (launch()) return;
+    {
+      std::lock_guard<std::mutex> lock(m);
+      if (failed != started) return; // another attempt is still running
+    }
+    if (!slots.claim(i)) return;
+    halt();
+    if (on_err) on_err(e);
+  }
+
+  void halt() {
+    {
+      std::lock_guard<std::mutex> lock(m);
+      stopped = true;
+    }
+    cv.notify_all();
+  }
+
+  // Timer loop (own thread): a duplicate whenever `delay` passed without an
+  // answer since the last attempt started
+  void run_timer() {
+    std::unique_lock<std::mutex> lock(m);
+    while (!stopped && started < max_attempts) {
+      const std::size_t n = started;
+      if (!cv.wait_until(lock, last_start + delay, [&]{ return stopped || started != n; })) {
+        lock.unlock();
+        launch();
+        lock.lock();
+      }
+    }
+  }
+};
+
+} // namespace detail
+
+// hedge(f, delay, max_attempts[, stats]): subscribes to f(); if nothing came
+// back within `delay`, subscribes to a duplicate f() as well, and so on up to
+// max_attempts attempts. The first attempt to emit anything wins and all the
+// others are cancelled (subscription::reset). An attempt that fails before any
+// answer starts the next one at once; the error is delivered only if every
+// attempt fails. stats, if given, counts how often duplicates fired and won -
+// tune `delay` to roughly the p95 of the call without hedging.
+// Each subscription that may hedge uses a short-lived timer thread; duplicates
+// are started (f() called) on it.
+template <class F>
+auto hedge(F f, std::chrono::steady_clock::duration delay, std::size_t max_attempts,
+           std::shared_ptr<hedge_counters> stats = nullptr) {
+  using O = std::decay_t<std::invoke_result_t<F&>>;
+  using U = typename O::value_type;
+  return observable<U>::create([f = std::move(f), delay, max_attempts, stats](auto on_next, auto on_err,
+                                                                              auto on_done){
+    auto st = std::make_shared<detail::hedge_state<U>>();
+    st->make = f;
+    st->delay = delay;
+    st->max_attempts = max_attempts ? max_attempts : 1;
+    st->stats = stats;
+    st->on_next = std::move(on_next);
+    st->on_err  = std::move(on_err);
+    st->on_done = std::move(on_done);
+    st->start();
+    return subscription([st]{
+      st->halt();
+      st->slots.stop();
+    });
+  });
+}
+
+} // namespace pulse
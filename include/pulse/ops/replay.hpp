@@ -0,0 +1,99 @@
+#pragma once
+#include <pulse/core/observable.hpp>
+#include <pulse/core/subscription.hpp>
+#include <pulse/core/replay_subject.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace pulse {
+
+// replay(n) / replay(window, capacity): share() that also replays the recent
+// history to late subscribers. The first subscriber connects the upstream, the last
+// one disconnects it; the buffer survives reconnects. Once the upstream has
+// terminated, new subscribers get the replay and the terminal event.
+struct op_replay {
+  std::size_t n;
+  std::optional<std::chrono::steady_clock::duration> window;
+
+  template <class T>
+  auto operator()(const observable<T>& src) const {
+    struct state {
+      explicit state(const op_replay& op)
+        : subj(op.window ? replay_subject<T>(*op.window, op.n) : replay_subject<T>(op.n)) {}
+      replay_subject<T> subj;
+      std::mutex m;
+      std::size_t refs{0};
+      bool finished{false};
+      std::uint64_t connection{0};   // bumped on every connect and disconnect
+      subscription upstream;
+    };
+    auto st = std::make_shared<state>(*this);
+
+    return observable<T>::create([src, st](auto on_next, auto on_err, auto on_done) {
+      auto down = std::make_shared<subscription>(
+        st->subj.as_observable().subscribe(std::move(on_next), std::move(on_err), std::move(on_done)));
+
+      bool need_connect = false;
+      std::uint64_t my_connection = 0;
+      {
+        std::lock_guard<std::mutex> lock(st->m);
+        need_connect = st->refs++ == 0 && !st->finished;
+        if (need_connect) my_connection = ++st->connection;
+      }
+
+      if (need_connect) {
+        std::weak_ptr<state> wst = st;
+        auto up = src.subscribe(
+          [wst](const T& v){ if (auto s = wst.lock()) s->subj.on_next(v); },
+          [wst](std::exception_ptr e){
+            if (auto s = wst.lock()) {
+              { std::lock_guard<std::mutex> lock(s->m); s->finished = true; }
+              s->subj.on_error(e);
+            }
+          },
+          [wst]{
+            if (auto s = wst.lock()) {
+              { std::lock_guard<std::mutex> lock(s->m); s->finished = true; }
+              s->subj.on_completed();
+            }
+          });
+        {
+          std::lock_guard<std::mutex> lock(st->m);
+          if (st->finished) {
+            up.release(); // terminated while connecting
+          } else if (st->refs > 0 && st->connection == my_connection) {
+            st->upstream = std::move(up);
+          }
+          // else: every subscriber left while connecting, `up` cancels below
+        }
+      }
+
+      return subscription([st, down]{
+        down->reset();
+        subscription up;
+        {
+          std::lock_guard<std::mutex> lock(st->m);
+          if (st->refs > 0 && --st->refs == 0) {
+            up = std::move(st->upstream);
+            ++st->connection;
+          }
+        }
+        up.reset(); // outside the lock
+      });
+    });
+  }
+};
+
+// Replays the last n values
+inline auto replay(std::size_t n) { return op_replay{ n, std::nullopt }; }
+
+// Replays the values of the last `window` (at most `capacity` of them)
+template <class Rep, class Period>
+inline auto replay(std::chrono::duration<Rep, Period> window, std::size_t capacity = 1024) {
+  return op_replay{ capacity, std::chrono::duration_cast<std::chrono::steady_clock::duration>(window) };
+}
+
+} // namespace pulse
@@ -21,6 +21,7 @@ struct op_subscribe_on {
     return observable<T>::create([src, ex = ex](auto on_next, auto on_error, auto on_completed) {
       struct state {
         std::atomic<bool> alive{true};
+        std::shared_ptr<cancel_group> group = std::make_shared<cancel_group>();
         subscription up;
       };
       auto st = std::make_shared<state>();
@@ -52,12 +53,13 @@ struct op_subscribe_on {
             }
           }
         );
-      });
+      }, st->group);
 
       // unsubscribe: extinguish alive and upstream
       return subscription([st]{
         if (!st) return;
         st->alive = false;
+        st->group->cancel(); // the subscribe task may still be queued
         st->up.reset();
       });
     });
@@ -79,6 +81,7 @@ struct op_subscribe_on_sp {
     return observable<T>::create([src, exec](auto on_next, auto on_error, auto on_completed) {
       struct state {
         std::atomic<bool> alive{true};
+        std::shared_ptr<cancel_group> group = std::make_shared<cancel_group>();
         subscription up;
       };
       auto st = std::make_shared<state>();
@@ -108,11 +111,12 @@ struct op_subscribe_on_sp {
             }
           }
         );
-      });
+      }, st->group);
 
       return subscription([st]{
         if (!st) return;
         st->alive = false;
+        st->group->cancel(); // the subscribe task may still be queued
         st->up.reset();
       });
     });
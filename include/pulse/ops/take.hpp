@@ -10,7 +10,7 @@ struct op_take {
   std::size_t n;
   template <class T>
   auto operator()(const observable<T>& src) const {
-    return observable<T>::create([src, n = n](auto on_next, auto on_err, auto on_done){
+    return observable<T>::create_flow([src, n = n](auto on_next, auto on_err, auto on_done, auto d){
       if (n == 0) {
         if (on_done) on_done();
         return subscription{};
@@ -34,7 +34,8 @@ struct op_take {
         },
         [on_done]{
           if (on_done) on_done();
-        }
+        },
+        d
       );
 
       composite->add(std::move(sub));
@@ -2,70 +2,340 @@
 #include <pulse/core/observable.hpp>
 #include <pulse/core/subscription.hpp>
 #include <pulse/core/composite_subscription.hpp>
-#include <deque>
+#include <pulse/core/demand.hpp>
+#include <pulse/core/spsc_ring.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 namespace pulse {
 
-// zip(oa, ob, f): buffers values ​​from A and B; as soon as a pair is found, emits f(a,b).
-// Termination: when one source has completed and its queue is empty, terminate the overall stream.
-template <class A, class B, class F>
-auto zip(const observable<A>& oa, const observable<B>& ob, F f) {
-  using R = std::invoke_result_t<F, const A&, const B&>;
-  return observable<R>::create([oa, ob, f = std::move(f)](auto on_next, auto on_err, auto on_done){
-    struct state_t {
-      std::mutex m;
-      std::deque<A> qa;
-      std::deque<B> qb;
-      bool doneA{false};
-      bool doneB{false};
-    };
-    auto st = std::make_shared<state_t>();
-    auto comp = std::make_shared<composite_subscription>();
-
-    auto try_emit = [st, on_next, &f, on_done, comp](){
-      std::optional<R> out;
-      {
-        std::lock_guard<std::mutex> lock(st->m);
-        if (!st->qa.empty() && !st->qb.empty()) {
-          A a = std::move(st->qa.front()); st->qa.pop_front();
-          B b = std::move(st->qb.front()); st->qb.pop_front();
-          out.emplace(f(a, b));
-        } else {
-          // if someone has finished and no more pairs can be collected, we close
-          if ((st->doneA && st->qa.empty()) || (st->doneB && st->qb.empty())) {
-            if (on_done) on_done();
-            comp->reset();
-          }
+// What zip does when a source runs more than `capacity` values ahead of the
+// slowest one: block (sources are only asked for what fits, via demand),
+// drop the new value, fail with std::overflow_error, or grow the buffer
+// (unbounded, what zip without options does).
+enum class zip_overflow { block, drop, error, grow };
+
+struct zip_options {
+  std::size_t capacity{1024};           // per source, rounded up to a power of two
+  zip_overflow overflow{zip_overflow::block};
+  // Every source emits from one thread at a time: pairing takes no lock.
+  // Otherwise each source serializes its pushes with a mutex of its own.
+  bool single_producer{false};
+};
+
+namespace detail {
+
+template <class T> const zip_options& same_options(const zip_options& o) { return o; }
+
+// Buffer of one zip source: an spsc_ring, or with zip_overflow::grow a chain
+// of them - a full ring links one twice its size, and the consumer moves on
+// once it has emptied the old one. Same threading rules as spsc_ring.
+template <class T>
+class zip_buffer {
+public:
+  explicit zip_buffer(const zip_options& o)
+    : grow_(o.overflow == zip_overflow::grow), head_(new segment(o.capacity)), tail_(head_) {}
+
+  ~zip_buffer() {
+    for (segment* s = head_; s;) {
+      segment* n = s->next.load(std::memory_order_relaxed);
+      delete s;
+      s = n;
+    }
+  }
+
+  zip_buffer(const zip_buffer&) = delete;
+  zip_buffer& operator=(const zip_buffer&) = delete;
+
+  // False if the ring is full and may not grow
+  bool try_push(const T& v) {
+    if (tail_->ring.try_push(v)) return true;
+    if (!grow_) return false;
+    auto* s = new segment(tail_->ring.capacity() * 2);
+    s->ring.try_push(v);
+    tail_->next.store(s, std::memory_order_release);
+    tail_ = s;
+    return true;
+  }
+
+  T* front() {
+    if (T* p = head_->ring.front()) return p;
+    segment* n = head_->next.load(std::memory_order_acquire);
+    if (!n) return nullptr;
+    if (T* p = head_->ring.front()) return p; // pushed before the next ring was linked
+    delete head_;
+    head_ = n;
+    return head_->ring.front();
+  }
+
+  void pop() { head_->ring.pop(); }
+  bool empty() { return front() == nullptr; }
+
+  // Fixed unless growing
+  std::size_t capacity() const noexcept { return head_->ring.capacity(); }
+
+private:
+  struct segment {
+    explicit segment(std::size_t c) : ring(c) {}
+    spsc_ring<T> ring;
+    std::atomic<segment*> next{nullptr};
+  };
+
+  const bool grow_;
+  segment* head_; // consumer
+  segment* tail_; // producer
+};
+
+// Shared state of zip(f, o1, ..., oN). Every source owns a zip_buffer; the
+// pairing loop runs on whichever source thread completes a tuple (wip/missed),
+// so with single_producer sources no lock is taken on the way.
+template <class R, class F, class... Ts>
+struct zip_state : std::enable_shared_from_this<zip_state<R, F, Ts...>> {
+  static constexpr std::size_t N = sizeof...(Ts);
+  using seq = std::index_sequence_for<Ts...>;
+
+  zip_state(F fn, zip_options o)
+    : f(std::move(fn)), overflow(o.overflow), single_producer(o.single_producer),
+      rings(same_options<Ts>(o)...) {
+    for (auto& u : up) u = std::make_shared<demand>();
+  }
+
+  F f;
+  const zip_overflow overflow;
+  const bool single_producer;
+  std::tuple<zip_buffer<Ts>...> rings;
+  std::array<std::mutex, N> producer_m;          // unless single_producer
+  std::array<std::atomic<bool>, N> done{};
+  std::array<std::shared_ptr<demand>, N> up;     // one demand per source
+  typename observable<R>::OnNext on_next;
+  typename observable<R>::OnErr  on_err;
+  typename observable<R>::OnDone on_done;
+  std::shared_ptr<composite_subscription> comp = std::make_shared<composite_subscription>();
+
+  std::atomic<bool> alive{true};
+  std::atomic<int> wip{0};
+  std::atomic<std::size_t> emitted{0};
+  std::atomic<std::size_t> refill_at{0};         // emitted count at which pump() has work
+
+  std::mutex pump_m;                             // credit bookkeeping only
+  std::size_t granted{0};                        // downstream credit so far
+  std::array<std::size_t, N> requested{};        // per source, so far
+
+  template <std::size_t I, class T>
+  void push(const T& v) {
+    if (!alive.load(std::memory_order_acquire)) return;
+    bool pushed;
+    if (single_producer) {
+      pushed = std::get<I>(rings).try_push(v);
+    } else {
+      std::lock_guard<std::mutex> lock(producer_m[I]);
+      pushed = std::get<I>(rings).try_push(v);
+    }
+    if (!pushed) {
+      if (overflow == zip_overflow::drop) return;
+      // error, or block with a source that ignores demand
+      fail(std::make_exception_ptr(std::overflow_error("zip: source buffer overflow")));
+      return;
+    }
+    drain();
+  }
+
+  template <std::size_t I>
+  void complete_source() {
+    done[I].store(true, std::memory_order_release);
+    drain();
+  }
+
+  void drain() {
+    if (wip.fetch_add(1, std::memory_order_acq_rel) != 0) return;
+    int missed = 1;
+    for (;;) {
+      std::size_t count = 0;
+      while (alive.load(std::memory_order_acquire)) {
+        if (!try_emit(seq{})) {
+          if (exhausted(seq{})) finish(nullptr);
+          break;
         }
+        ++count;
       }
-      if (out && on_next) on_next(*out);
-    };
-
-    auto sa = oa.subscribe(
-      [st, try_emit](const A& a){
-        { std::lock_guard<std::mutex> lock(st->m); st->qa.push_back(a); }
-        try_emit();
-      },
-      [comp, on_err](std::exception_ptr e){ if (on_err) on_err(e); comp->reset(); },
-      [st, try_emit]{ { std::lock_guard<std::mutex> lock(st->m); st->doneA = true; } try_emit(); }
-    );
-
-    auto sb = ob.subscribe(
-      [st, try_emit](const B& b){
-        { std::lock_guard<std::mutex> lock(st->m); st->qb.push_back(b); }
-        try_emit();
-      },
-      [comp, on_err](std::exception_ptr e){ if (on_err) on_err(e); comp->reset(); },
-      [st, try_emit]{ { std::lock_guard<std::mutex> lock(st->m); st->doneB = true; } try_emit(); }
-    );
-
-    comp->add(std::move(sa));
-    comp->add(std::move(sb));
-    return subscription([comp]{ comp->reset(); });
+      if (count) {
+        // only the drain loop writes `emitted`
+        const std::size_t out = emitted.load(std::memory_order_relaxed) + count;
+        emitted.store(out, std::memory_order_release);
+        if (out >= refill_at.load(std::memory_order_acquire)) pump();
+      }
+      missed = wip.fetch_sub(missed, std::memory_order_acq_rel) - missed;
+      if (missed == 0) break;
+    }
+  }
+
+  // One tuple if every ring has a value
+  template <std::size_t... I>
+  bool try_emit(std::index_sequence<I...>) {
+    std::tuple<Ts*...> heads{ std::get<I>(rings).front()... };
+    if (((std::get<I>(heads) == nullptr) || ...)) return false;
+    std::optional<R> out;
+    try {
+      out.emplace(f(*std::get<I>(heads)...));
+    } catch (...) {
+      (std::get<I>(rings).pop(), ...);
+      fail(std::current_exception());
+      return false;
+    }
+    (std::get<I>(rings).pop(), ...);
+    if (on_next) on_next(*out);
+    return true;
+  }
+
+  // A completed source with an empty ring: no further tuple is possible
+  template <std::size_t... I>
+  bool exhausted(std::index_sequence<I...>) {
+    return ((done[I].load(std::memory_order_acquire) && std::get<I>(rings).empty()) || ...);
+  }
+
+  // Downstream granted n more tuples
+  void grant(std::size_t n) {
+    {
+      std::lock_guard<std::mutex> lock(pump_m);
+      granted = (granted > demand::unbounded - n) ? demand::unbounded : granted + n;
+    }
+    pump();
+  }
+
+  // Asks every source for what the credit (and, in block mode, its ring) allows
+  void pump() { pump(seq{}); }
+
+  template <std::size_t... I>
+  void pump(std::index_sequence<I...>) {
+    std::array<std::size_t, N> n{};
+    {
+      std::lock_guard<std::mutex> lock(pump_m);
+      const std::size_t out = emitted.load(std::memory_order_acquire);
+      std::size_t next = demand::unbounded;
+      (pump_one<I>(out, n, next), ...);
+      refill_at.store(next, std::memory_order_release);
+    }
+    for (std::size_t i = 0; i < N; ++i)
+      if (n[i]) up[i]->request(n[i]);
+  }
+
+  template <std::size_t I>
+  void pump_one(std::size_t out, std::array<std::size_t, N>& n, std::size_t& next) {
+    std::size_t target = granted;
+    std::size_t batch = 1;
+    if (overflow == zip_overflow::block) {
+      const std::size_t cap = std::get<I>(rings).capacity();
+      if (out + cap < target) {
+        // limited by the ring: refill in halves instead of one request per tuple
+        // (the source still holds the other half of its credit)
+        target = out + cap;
+        batch = std::max<std::size_t>(1, cap / 2);
+      }
+    }
+    if (requested[I] != demand::unbounded && target >= requested[I] + batch) {
+      n[I] = target == demand::unbounded ? demand::unbounded : target - requested[I];
+      requested[I] = target;
+    }
+    // Only the ring limit moves with emitted tuples; more credit comes via grant()
+    if (overflow == zip_overflow::block && requested[I] < granted) {
+      const std::size_t cap = std::get<I>(rings).capacity();
+      const std::size_t due = requested[I] + std::max<std::size_t>(1, cap / 2);
+      next = std::min(next, due > cap ? due - cap : 0);
+    }
+  }
+
+  void fail(std::exception_ptr e) { finish(e); }
+
+  void finish(std::exception_ptr e) {
+    if (!alive.exchange(false, std::memory_order_acq_rel)) return;
+    if (e) { if (on_err) on_err(e); }
+    else if (on_done) on_done();
+    comp->reset();
+  }
+};
+
+template <class R, class F, class... Ts, std::size_t... I>
+void zip_subscribe_all(const std::shared_ptr<zip_state<R, F, Ts...>>& st,
+                       const std::tuple<observable<Ts>...>& sources, bool flow,
+                       std::index_sequence<I...>) {
+  // Strong captures (no weak_ptr lock per value): the cycle through comp is
+  // broken when the zip terminates or is cancelled
+  (st->comp->add(std::get<I>(sources).subscribe(
+     [st](const Ts& v){ st->template push<I>(v); },
+     [st](std::exception_ptr e){ st->fail(e); },
+     [st]{ st->template complete_source<I>(); },
+     flow ? st->up[I] : nullptr)), ...);
+}
+
+} // namespace detail
+
+// zip(opts, f, o1, ..., oN): takes one value from every source and emits
+// f(v1, ..., vN). Values wait in a fixed-size ring per source (opts.capacity);
+// what happens when a source gets too far ahead is opts.overflow. With
+// zip_overflow::block (the options' default) sources are asked only for as
+// many values as fit into their ring and the downstream credit allows; a
+// source that ignores demand and overflows anyway fails the stream. Hot
+// sources (subject) then keep the excess in their own per-subscriber gate;
+// drop, error and grow skip the metering when the downstream has no demand.
+// A source may emit from several threads at once unless opts.single_producer
+// is set, which makes pairing lock-free; f runs on the thread that completes
+// a tuple.
+// Termination: when one source has completed and its ring is empty, the
+// overall stream completes. Any error cancels the other sources.
+template <class F, class... Ts>
+auto zip(zip_options opts, F f, const observable<Ts>&... sources) {
+  static_assert(sizeof...(Ts) >= 1, "zip needs at least one source");
+  using R = std::decay_t<std::invoke_result_t<F&, const Ts&...>>;
+  return observable<R>::create_flow([opts, f = std::move(f), srcs = std::make_tuple(sources...)](
+                                      auto on_next, auto on_err, auto on_done, std::shared_ptr<demand> d){
+    using state_t = detail::zip_state<R, F, Ts...>;
+    auto st = std::make_shared<state_t>(f, opts);
+    st->on_next = std::move(on_next);
+    st->on_err  = std::move(on_err);
+    st->on_done = std::move(on_done);
+
+    // drop/error/grow without downstream demand: nothing to meter, sources run free
+    const bool flow = d || opts.overflow == zip_overflow::block;
+    detail::zip_subscribe_all(st, srcs, flow, std::index_sequence_for<Ts...>{});
+
+    if (d) {
+      std::weak_ptr<state_t> w = st;
+      auto l = forward_demand(d, [w](std::size_t n){ if (auto s = w.lock()) s->grant(n); });
+      st->comp->add(subscription([d, l]{ d->remove(l); }));
+    } else {
+      st->grant(demand::unbounded);
+    }
+    return subscription([st]{
+      st->alive.store(false, std::memory_order_release);
+      st->comp->reset();
+    });
   });
 }
 
+// zip(f, o1, ..., oN): unbounded buffers (zip_overflow::grow), so a source
+// that ignores demand is never cut off; the downstream credit still meters
+// demand-aware sources
+template <class F, class... Ts>
+  requires (!detail::is_observable<std::decay_t<F>>::value &&
+            !std::is_same_v<std::decay_t<F>, zip_options>)
+auto zip(F f, const observable<Ts>&... sources) {
+  return zip(zip_options{.overflow = zip_overflow::grow}, std::move(f), sources...);
+}
+
+// zip(oa, ob, f): the two-source form
+template <class A, class B, class F>
+auto zip(const observable<A>& oa, const observable<B>& ob, F f) {
+  return zip(zip_options{.overflow = zip_overflow::grow}, std::move(f), oa, ob);
+}
+
 } // namespace pulse
@@ -2,16 +2,28 @@
 #include <pulse/version.hpp>
 
 #include <pulse/core/subscription.hpp>
+#include <pulse/core/cancel_group.hpp>
 #include <pulse/core/scheduler.hpp>
+#include <pulse/core/bp_stats.hpp>
 #include <pulse/core/backpressure.hpp>
+#include <pulse/core/latest_cell.hpp>
 #include <pulse/core/topic.hpp>
 
 #include <pulse/core/observable.hpp>
 #include <pulse/core/pipeline.hpp>
 #include <pulse/core/topic_to_observable.hpp>
 #include <pulse/core/composite_subscription.hpp>
+#include <pulse/core/mpsc_queue.hpp>
+#include <pulse/core/spsc_ring.hpp>
+#include <pulse/core/lru_cache.hpp>
+#include <pulse/core/cpu_topology.hpp>
 #include <pulse/core/thread_pool.hpp>
+#include <pulse/core/multicast_hub.hpp>
+#include <pulse/core/demand.hpp>
 #include <pulse/core/subject.hpp>
+#include <pulse/core/replay_subject.hpp>
+#include <pulse/core/behavior_subject.hpp>
+#include <pulse/core/cell.hpp>
 
 #include <pulse/ops/map.hpp>
 #include <pulse/ops/filter.hpp>
@@ -23,6 +35,9 @@
 #include <pulse/ops/take.hpp>
 #include <pulse/ops/retry.hpp>
 #include <pulse/ops/share.hpp>
+#include <pulse/ops/keyed_share.hpp>
+#include <pulse/ops/cached.hpp>
+#include <pulse/ops/replay.hpp>
 #include <pulse/ops/combine_latest.hpp>
 #include <pulse/ops/start_with.hpp>
 #include <pulse/ops/timer.hpp>
@@ -32,8 +47,12 @@
 #include <pulse/ops/throttle_latest.hpp>
 #include <pulse/ops/buffer.hpp>
 #include <pulse/ops/concat_map.hpp>
+#include <pulse/ops/merge_map.hpp>
+#include <pulse/ops/parallel_map.hpp>
+#include <pulse/ops/race.hpp>
 #include <pulse/ops/subscribe_on.hpp>
 #include <pulse/ops/merge.hpp>
 #include <pulse/ops/window.hpp>
+#include <pulse/ops/from_range.hpp>
 
 
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <vector>
 #include <thread>
@@ -5,10 +7,23 @@
 #include <pulse/pulse.hpp>
 #include <pulse/core/backpressure.hpp>
 #include <iostream>
+#include <mutex>
 
 using namespace pulse;
 using namespace std::chrono_literals;
 
+// Manually advanced monotonic clock for the TTL policy
+struct manual_clock {
+  using duration = std::chrono::milliseconds;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<manual_clock>;
+  static constexpr bool is_steady = true;
+  static inline time_point current{};
+  static time_point now() noexcept { return current; }
+  static void advance(duration d) { current += d; }
+};
+
 int main() {
   inline_executor ui;
   topic<int> t;
@@ -45,6 +60,158 @@ int main() {
   assert(latest_got.back() == 9 && "The final value should come last.");
   assert(latest_got.size() <= 3 && "bp_latest should shorten the sequence significantly");
 
+  // --- bp_latest_by_key: one delivery per key per burst, freshest value, first-dirty order ---
+  {
+    struct tick { int sym; int px; };
+    auto by_sym = [](const tick& q){ return q.sym; };
+    using policy = bp_latest_by_key<tick, decltype(by_sym)>;
+
+    strand slow; // drained manually: the consumer is "busy" until drain()
+    topic<tick> quotes;
+    std::vector<std::pair<int,int>> got;
+    auto s3 = quotes.subscribe(slow, priority{0}, policy{}, [&](const tick& q){
+      got.emplace_back(q.sym, q.px);
+    });
+
+    for (int px = 0; px < 100; ++px) {
+      quotes.publish({2, px});
+      quotes.publish({1, 1000 + px});
+      quotes.publish({3, 2000 + px});
+    }
+    slow.drain();
+    assert((got == std::vector<std::pair<int,int>>{{2, 99}, {1, 1099}, {3, 2099}})
+           && "bp_latest_by_key: latest value per key, in the order keys became dirty");
+
+    got.clear();
+    quotes.publish({3, 1});
+    quotes.publish({3, 2});
+    slow.drain();
+    assert((got == std::vector<std::pair<int,int>>{{3, 2}}) && "a new burst is delivered again");
+  }
+
+  // --- bp_ttl: events older than the TTL are skipped at dequeue time ---
+  {
+    strand slow;
+    topic<int> prices;
+    auto p = std::make_shared<bp_ttl<int, manual_clock>>(200ms);
+    std::vector<int> got;
+    auto s4 = prices.subscribe(slow, priority{0}, p, [&](int v){ got.push_back(v); });
+
+    prices.publish(1);
+    prices.publish(2);
+    manual_clock::advance(150ms);
+    prices.publish(3);
+    manual_clock::advance(100ms); // 1, 2 are 250ms old, 3 is 100ms old
+    slow.drain();
+    assert((got == std::vector<int>{3}) && "bp_ttl: stale events are skipped");
+    if constexpr (bp_stats::enabled) assert(p->stats().expired == 2);
+
+    got.clear();
+    prices.publish(4);
+    manual_clock::advance(300ms);
+    slow.drain();
+    assert(got.empty() && "bp_ttl(drop): a burst of only stale events delivers nothing");
+  }
+
+  // --- bp_ttl(newest): the newest stale event survives if nothing fresher follows ---
+  {
+    strand slow;
+    topic<int> prices;
+    auto p = std::make_shared<bp_ttl<int, manual_clock>>(200ms, 1024, ttl_stale::newest);
+    std::vector<int> got;
+    auto s5 = prices.subscribe(slow, priority{0}, p, [&](int v){ got.push_back(v); });
+
+    for (int i = 0; i < 5; ++i) prices.publish(i);
+    manual_clock::advance(300ms);
+    slow.drain();
+    assert((got == std::vector<int>{4}) && "bp_ttl(newest): only the newest stale one");
+
+    got.clear();
+    prices.publish(5);
+    manual_clock::advance(300ms);
+    prices.publish(6);
+    slow.drain();
+    assert((got == std::vector<int>{6}) && "bp_ttl(newest): a fresh event supersedes it");
+    if constexpr (bp_stats::enabled) assert(p->stats().expired == 4 + 1);
+  }
+
+  // --- bp_rate(drop): bursts up to `burst`, then the sustained rate ---
+  {
+    topic<int> t6;
+    int n = 0;
+    auto s6 = t6.subscribe(ui, priority{0}, bp_rate<int>{100.0, 5}, [&](int){ ++n; });
+    for (int i = 0; i < 20; ++i) t6.publish(i);
+    assert(n == 5 && "bp_rate: an instant burst is capped at `burst`");
+    std::this_thread::sleep_for(100ms); // ~10 tokens refilled, capped at 5
+    for (int i = 0; i < 20; ++i) t6.publish(i);
+    assert(n == 10 && "bp_rate: the bucket refills up to `burst`");
+  }
+
+  // --- bp_rate(defer): excess waits in a bounded queue, drained in order by a timer ---
+  {
+    thread_pool writer{1};
+    topic<int> t7;
+    std::mutex m;
+    std::vector<int> got;
+    auto p = std::make_shared<bp_rate<int>>(200.0, 2, rate_excess::defer, 6);
+    auto s7 = t7.subscribe(writer, priority{0}, p, [&](int v){
+      std::lock_guard<std::mutex> lock(m);
+      got.push_back(v);
+    });
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10; ++i) t7.publish(i); // 2 admitted, 6 deferred, 2 dropped
+    for (int spin = 0; spin < 200; ++spin) {
+      { std::lock_guard<std::mutex> lock(m); if (got.size() == 8) break; }
+      std::this_thread::sleep_for(5ms);
+    }
+    const auto took = std::chrono::steady_clock::now() - t0;
+    std::lock_guard<std::mutex> lock(m);
+    assert((got == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7}) && "bp_rate(defer): FIFO, bounded");
+    assert(took >= 25ms && "bp_rate(defer): 6 deferred events at 200/s take ~30ms");
+    if constexpr (bp_stats::enabled) {
+      auto st = p->stats();
+      assert(st.accepted == 8 && st.dropped == 2 && st.high_water == 6 && st.depth == 0);
+    }
+  }
+
+  // --- bp_rate(defer): unsubscribing stops the timer, deferred events are discarded ---
+  {
+    thread_pool writer{1};
+    topic<int> t8;
+    std::atomic<int> n{0};
+    auto p = std::make_shared<bp_rate<int>>(5.0, 1, rate_excess::defer, 16);
+    auto s8 = t8.subscribe(writer, priority{0}, p, [&](int){ ++n; });
+    for (int i = 0; i < 10; ++i) t8.publish(i); // 1 now, 9 would take ~2s
+    std::this_thread::sleep_for(50ms);
+    s8.reset();
+    std::this_thread::sleep_for(400ms); // two more tokens' worth
+    assert(n == 1 && "bp_rate: nothing is delivered after unsubscribe");
+    if constexpr (bp_stats::enabled) assert(p->stats().depth == 0 && "the deferred queue is dropped");
+  }
+
+  // --- bp_rate(defer): fresh tokens never let a new event overtake queued ones ---
+  {
+    thread_pool writer{1};
+    topic<int> t9;
+    std::mutex m;
+    std::vector<int> got;
+    auto p = std::make_shared<bp_rate<int>>(2000.0, 1, rate_excess::defer, 4096);
+    auto s9 = t9.subscribe(writer, priority{0}, p, [&](int v){
+      std::lock_guard<std::mutex> lock(m);
+      got.push_back(v);
+    });
+    for (int i = 0; i < 300; ++i) {
+      t9.publish(i);
+      if (i % 3 == 0) std::this_thread::sleep_for(std::chrono::microseconds(400));
+    }
+    for (int spin = 0; spin < 400; ++spin) {
+      { std::lock_guard<std::mutex> lock(m); if (got.size() == 300) break; }
+      std::this_thread::sleep_for(5ms);
+    }
+    std::lock_guard<std::mutex> lock(m);
+    assert(got.size() == 300 && std::is_sorted(got.begin(), got.end()) && "bp_rate(defer): FIFO");
+  }
+
   std::cout << "[backpressure_tests] OK\n";
   return 0;
 }
@@ -0,0 +1,127 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <pulse/pulse.hpp>
+#include <iostream>
+
+using namespace pulse;
+using namespace std::chrono_literals;
+
+int main() {
+  // lru_cache: least recently used entry goes first, get() refreshes recency
+  {
+    lru_cache<int, std::string> c(3, 0s, 1);
+    c.put(1, "a");
+    c.put(2, "b");
+    c.put(3, "c");
+    assert(c.get(1) == std::optional<std::string>("a"));
+    c.put(4, "d");                     // evicts 2
+    assert(!c.get(2) && c.get(3) && c.get(4) && c.get(1));
+    c.put(3, "C");                     // replace, no eviction
+    assert(*c.get(3) == "C" && c.size() == 3);
+    const auto s = c.stats();
+    assert(s.evictions == 1 && s.hits == 5 && s.misses == 1 && s.size == 3);
+  }
+
+  // lru_cache: entries expire after the TTL
+  {
+    lru_cache<std::string, int> c(16, 20ms);
+    c.put("k", 1);
+    assert(c.get("k") == std::optional<int>(1));
+    std::this_thread::sleep_for(40ms);
+    assert(!c.get("k"));
+    const auto s = c.stats();
+    assert(s.expired == 1 && s.misses == 1 && s.size == 0);
+  }
+
+  // lru_cache: shards split the capacity and never hold more than it
+  {
+    lru_cache<int, int> c(1024);
+    assert(c.shard_count() == 16);
+    std::vector<std::thread> ts;
+    for (int t = 0; t < 4; ++t) {
+      ts.emplace_back([&c, t]{
+        for (int i = 0; i < 5000; ++i) {
+          c.put(t * 5000 + i, i);
+          (void)c.get(t * 5000 + i / 2);
+        }
+      });
+    }
+    for (auto& th : ts) th.join();
+    const auto s = c.stats();
+    assert(s.size <= 1024 && s.evictions == 20000 - s.size);
+  }
+
+  // cached: a completed call is replayed synchronously; f runs once per argument
+  {
+    int calls = 0;
+    auto search = cached<std::string>([&](const std::string& q){
+      ++calls;
+      return from_range(std::vector<std::string>{q + "1", q + "2"});
+    }, 64, 10s);
+
+    std::vector<std::string> first, again;
+    bool done = false;
+    auto s1 = search("ab").subscribe([&](const std::string& v){ first.push_back(v); });
+    auto s2 = search("ab").subscribe([&](const std::string& v){ again.push_back(v); }, nullptr,
+                                     [&]{ done = true; });
+    assert(calls == 1 && done);
+    assert((again == std::vector<std::string>{"ab1", "ab2"}) && again == first);
+    auto s3 = search("abc").subscribe([](const std::string&){});
+    assert(calls == 2);
+    const auto st = search.stats();
+    assert(st.hits == 1 && st.misses == 2 && st.size == 2);
+    search.invalidate();
+    auto s4 = search("ab").subscribe([](const std::string&){});
+    assert(calls == 3);
+  }
+
+  // cached: errors and calls cancelled before completion are not cached
+  {
+    int calls = 0;
+    subject<int> backend;
+    bool fail = true;
+    auto f = cached<int>([&](int){
+      ++calls;
+      if (fail) return observable<int>::create([](auto, auto on_err, auto){
+        on_err(std::make_exception_ptr(std::runtime_error("backend")));
+        return subscription{};
+      });
+      return backend.as_observable();
+    }, 8, 0s);
+
+    bool failed = false;
+    auto s1 = f(1).subscribe([](int){}, [&](std::exception_ptr){ failed = true; });
+    assert(failed);
+    fail = false;
+    auto s2 = f(1).subscribe([](int){});
+    backend.on_next(5);
+    s2.reset();                        // cancelled before completion
+    auto s3 = f(1).subscribe([](int){});
+    assert(calls == 3 && f.stats().size == 0);
+  }
+
+  // cached: composes with switch_map; repeated prefixes do not reach the backend
+  {
+    std::atomic<int> calls{0};
+    auto search = cached<std::string>([&](const std::string& q){
+      ++calls;
+      return from_range(std::vector<std::string>{"result for " + q});
+    }, 128, 30s);
+
+    subject<std::string> typed;
+    std::vector<std::string> got;
+    auto sub = (typed.as_observable() | switch_map(search))
+                 .subscribe([&](const std::string& r){ got.push_back(r); });
+    for (const char* q : {"qu", "que", "qu", "que", "query", "qu"}) typed.on_next(q);
+    assert(got.size() == 6 && got.back() == "result for qu");
+    assert(calls == 3);
+  }
+
+  std::cout << "cached tests passed\n";
+  return 0;
+}
@@ -0,0 +1,118 @@
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <thread>
+
+#include <pulse/pulse.hpp>
+
+using namespace pulse;
+using namespace std::chrono_literals;
+
+// Occupies the (single) worker of a pool until open() is called.
+struct Gate {
+  std::promise<void> p;
+  std::shared_future<void> f{p.get_future().share()};
+  void block(executor& ex) { ex.post([f = f]{ f.wait(); }); }
+  void open() { p.set_value(); }
+};
+
+int main() {
+  // 1) Queued tasks of a cancelled group are unlinked and never run
+  {
+    thread_pool pool{1};
+    Gate gate;
+    gate.block(pool);
+
+    auto g = std::make_shared<cancel_group>();
+    std::atomic<int> ran{0};
+    for (int i = 0; i < 100; ++i) pool.post([&]{ ran.fetch_add(1); }, g);
+
+    g->cancel();
+    pool.post([&]{ ran.fetch_add(1); }, g); // after cancel - rejected
+
+    gate.open();
+    std::promise<void> flushed;
+    pool.post([&]{ flushed.set_value(); });
+    flushed.get_future().wait();
+
+    assert(ran.load() == 0 && "cancelled tasks must not run");
+    assert(pool.dropped_tasks() == 101 && "every cancelled task is counted as dropped");
+  }
+
+  // 2) Other groups and plain tasks are not affected
+  {
+    thread_pool pool{1};
+    Gate gate;
+    gate.block(pool);
+
+    auto a = std::make_shared<cancel_group>();
+    auto b = std::make_shared<cancel_group>();
+    std::atomic<int> ran_a{0}, ran_b{0}, ran_plain{0};
+    for (int i = 0; i < 10; ++i) {
+      pool.post([&]{ ran_a.fetch_add(1); }, a);
+      pool.post([&]{ ran_b.fetch_add(1); }, b);
+      pool.post([&]{ ran_plain.fetch_add(1); });
+    }
+    a->cancel();
+    gate.open();
+
+    std::promise<void> flushed;
+    pool.post([&]{ flushed.set_value(); });
+    flushed.get_future().wait();
+
+    assert(ran_a.load() == 0);
+    assert(ran_b.load() == 10 && ran_plain.load() == 10);
+  }
+
+  // 3) observe_on: unsubscribe drops deliveries that are still queued in the pool
+  {
+    thread_pool pool{1};
+    Gate gate;
+    subject<int> s;
+    std::atomic<int> got{0};
+
+    auto sub = (s.as_observable() | observe_on(pool)).subscribe([&](int){ got.fetch_add(1); });
+    gate.block(pool);
+    for (int i = 0; i < 50; ++i) s.on_next(i);
+    sub.reset();
+    gate.open();
+
+    std::promise<void> flushed;
+    pool.post([&]{ flushed.set_value(); });
+    flushed.get_future().wait();
+
+    assert(got.load() == 0 && "observe_on: reset() must drop queued deliveries");
+    assert(pool.dropped_tasks() == 50);
+  }
+
+  // 4) Generic fallback (strand): cancelled tasks are skipped when drained
+  {
+    strand st;
+    auto g = std::make_shared<cancel_group>();
+    int ran = 0;
+    st.post([&]{ ++ran; }, g);
+    st.post([&]{ ++ran; }, g);
+    auto sub = make_subscription(g);
+    sub.reset();
+    st.drain();
+    assert(ran == 0 && "fallback: tasks of a cancelled group are skipped");
+  }
+
+  // 5) Cancelling the group from inside one of its running tasks
+  {
+    thread_pool pool{1};
+    auto g = std::make_shared<cancel_group>();
+    std::atomic<int> ran{0};
+    std::promise<void> done;
+    pool.post([&]{ ran.fetch_add(1); g->cancel(); done.set_value(); }, g);
+    pool.post([&]{ ran.fetch_add(1); }, g);
+    done.get_future().wait();
+    std::this_thread::sleep_for(20ms);
+    assert(ran.load() == 1 && "cancel from a running task drops the rest of the group");
+  }
+
+  std::cout << "[cancel_group_tests] OK\n";
+  return 0;
+}
@@ -0,0 +1,206 @@
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <pulse/pulse.hpp>
+#include <iostream>
+
+using namespace pulse;
+
+int main() {
+  // Basics: computed follows its inputs
+  {
+    cell_graph g;
+    cell<int> a{g, 1};
+    cell<int> b{g, 2};
+    computed sum([](int x, int y){ return x + y; }, a, b);
+    computed<std::string> label([](int s){ return "sum=" + std::to_string(s); }, sum);
+    assert(sum.get() == 3 && label.get() == "sum=3");
+    a.set(10);
+    assert(sum.get() == 12 && label.get() == "sum=12");
+  }
+
+  // Diamond: one recomputation of the join per write, observers never see a glitch
+  {
+    cell_graph g;
+    cell<int> a{g, 1};
+    std::atomic<int> d_runs{0};
+    computed b([](int x){ return x + 1; }, a);
+    computed c([](int x){ return x * 2; }, a);
+    computed d([&](int x, int y){ ++d_runs; return x + y; }, b, c);
+    assert(d.get() == 4 && d_runs == 1);
+
+    std::vector<int> seen;
+    auto sub = d.as_observable().subscribe([&](int v){
+      seen.push_back(v);
+      assert(v == (a.get() + 1) + a.get() * 2 && "observer must see a consistent graph");
+    });
+    for (int i = 2; i <= 5; ++i) a.set(i);
+    assert(d_runs == 5 && "one recomputation of the join per commit");
+    assert((seen == std::vector<int>{4, 7, 10, 13, 16}) && "current value, then one value per commit");
+  }
+
+  // Equal values short-circuit: neither recomputation nor notification downstream
+  {
+    cell_graph g;
+    cell<int> a{g, 2};
+    int below = 0;
+    computed parity([](int x){ return x % 2; }, a);
+    computed flag([&](int p){ ++below; return p == 0; }, parity);
+    int notified = 0;
+    auto sub = parity.as_observable().subscribe([&](int){ ++notified; });
+    assert(below == 1 && notified == 1);
+
+    a.set(4);             // parity stays 0
+    a.set(4);             // input unchanged
+    assert(below == 1 && notified == 1 && flag.get());
+    a.set(5);
+    assert(below == 2 && notified == 2 && !flag.get());
+  }
+
+  // Transaction: several writes, one commit
+  {
+    cell_graph g;
+    cell<int> qty{g, 1};
+    cell<double> px{g, 10.0};
+    int runs = 0;
+    computed notional([&](int q, double p){ ++runs; return q * p; }, qty, px);
+    std::vector<double> seen;
+    auto sub = notional.as_observable().subscribe([&](double v){ seen.push_back(v); });
+
+    g.transaction([&]{
+      qty.set(3);
+      px.set(20.0);
+      assert(notional.get() == 10.0 && "inside the transaction the previous commit is visible");
+    });
+    assert(runs == 2 && notional.get() == 60.0);
+    assert((seen == std::vector<double>{10.0, 60.0}));
+  }
+
+  // Writes from an observer run as a follow-up round, after the current notifications
+  {
+    cell_graph g;
+    cell<int> in{g, 0};
+    cell<int> echo{g, 0};
+    computed both([](int x, int y){ return x * 100 + y; }, in, echo);
+    std::vector<int> seen;
+    auto s1 = in.as_observable().subscribe([&](int v){ echo.set(v); });
+    auto s2 = both.as_observable().subscribe([&](int v){ seen.push_back(v); });
+    in.set(7);
+    assert((seen == std::vector<int>{0, 700, 707}));
+    s1.reset();
+    in.set(8);
+    assert(seen.back() == 807 && echo.get() == 7);
+  }
+
+  // A transaction opened by an observer is deferred the same way: one follow-up round
+  {
+    cell_graph g;
+    cell<int> in{g, 0};
+    cell<int> x{g, 0};
+    cell<int> y{g, 0};
+    computed all([](int i, int a, int b){ return i * 100 + a + b; }, in, x, y);
+    std::vector<int> seen;
+    auto s1 = in.as_observable().subscribe([&](int v){
+      g.transaction([&]{ x.set(v); y.set(v); });
+    });
+    auto s2 = all.as_observable().subscribe([&](int v){ seen.push_back(v); });
+    in.set(7);
+    assert((seen == std::vector<int>{0, 700, 714}) && "no nested commit inside a round");
+    in.set(8);
+    assert((seen == std::vector<int>{0, 700, 714, 814, 816}));
+  }
+
+  // Unsubscribing stops the notifications; computed cells keep their inputs alive
+  {
+    cell_graph g;
+    std::optional<computed<int>> twice;
+    {
+      cell<int> a{g, 1};
+      twice.emplace([](int x){ return 2 * x; }, a);
+      int n = 0;
+      auto sub = twice->as_observable().subscribe([&](int){ ++n; });
+      a.set(2);
+      sub.reset();
+      a.set(3);
+      assert(n == 2 && twice->get() == 6);
+    }
+    assert(twice->get() == 6);
+  }
+
+  // A throwing computation fails the write and leaves the graph usable
+  {
+    cell_graph g;
+    cell<int> a{g, 1};
+    computed inv([](int x){
+      if (x == 0) throw std::domain_error("zero");
+      return 100 / x;
+    }, a);
+    bool thrown = false;
+    try { a.set(0); } catch (const std::domain_error&) { thrown = true; }
+    assert(thrown && inv.get() == 100);
+    a.set(4);
+    assert(inv.get() == 25);
+  }
+
+  // Mixing graphs is rejected
+  {
+    cell_graph g1, g2;
+    cell<int> a{g1, 1};
+    cell<int> b{g2, 1};
+    bool thrown = false;
+    try { computed bad([](int x, int y){ return x + y; }, a, b); } catch (const std::invalid_argument&) { thrown = true; }
+    assert(thrown);
+  }
+
+  // 2k nodes: a write recomputes only the cone below the changed input
+  {
+    cell_graph g;
+    constexpr int inputs = 100, per_input = 20;
+    std::vector<cell<double>> in;
+    for (int i = 0; i < inputs; ++i) in.emplace_back(g, 1.0);
+    std::vector<computed<double>> nodes;
+    std::vector<computed<double>> books;
+    for (int i = 0; i < inputs; ++i) {
+      nodes.emplace_back([](double x){ return x * 1.01; }, in[i]);
+      for (int k = 1; k < per_input - 1; ++k)
+        nodes.emplace_back([](double x){ return x + 0.5; }, nodes.back());
+      books.emplace_back([](double x, double y){ return x + y; }, nodes.back(), in[i]);
+    }
+    computed<double> total([](double x, double y){ return x + y; }, books[0], books[1]);
+    assert(nodes.size() + books.size() + 1 + inputs > 2000);
+
+    const std::size_t before = g.recomputations();
+    in[0].set(2.0);
+    assert(g.recomputations() - before == per_input + 1 && "the chain of input 0, its book and total");
+    const std::size_t mid = g.recomputations();
+    in[50].set(3.0);
+    assert(g.recomputations() - mid == per_input && "the chain of input 50 and its book");
+    assert(total.get() == books[0].get() + books[1].get());
+  }
+
+  // Writers on several threads: every commit is atomic
+  {
+    cell_graph g;
+    cell<int> a{g, 0};
+    cell<int> b{g, 0};
+    computed diff([](int x, int y){ return x - y; }, a, b);
+    std::atomic<bool> bad{false};
+    auto sub = diff.as_observable().subscribe([&](int v){ if (v != 0) bad = true; });
+    std::vector<std::thread> ts;
+    for (int t = 0; t < 4; ++t) {
+      ts.emplace_back([&, t]{
+        for (int i = 1; i <= 500; ++i) g.transaction([&]{ a.set(t * 1000 + i); b.set(t * 1000 + i); });
+      });
+    }
+    for (auto& th : ts) th.join();
+    assert(!bad && diff.get() == 0);
+  }
+
+  std::cout << "cell tests passed\n";
+  return 0;
+}
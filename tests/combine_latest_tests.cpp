@@ -1,4 +1,8 @@
+#include <atomic>
 #include <cassert>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <vector>
 #include <pulse/pulse.hpp>
 #include <iostream>
@@ -23,6 +27,110 @@ int main() {
 
   assert((got == std::vector<int>{11,12,22}) && "combine_latest should combine with the latest known values");
   sub.reset();
+
+  // Variadic: waits for every source, completes when all of them completed
+  {
+    subject<int> x;
+    subject<std::string> y;
+    subject<double> z;
+    std::vector<std::string> out;
+    bool done = false;
+    auto s = combine_latest([](int i, const std::string& t, double d){ return t + std::to_string(i + static_cast<int>(d)); },
+                            x.as_observable(), y.as_observable(), z.as_observable())
+               .subscribe([&](const std::string& v){ out.push_back(v); }, nullptr, [&]{ done = true; });
+    x.on_next(1);
+    y.on_next("a");
+    assert(out.empty());
+    z.on_next(10);
+    y.on_next("b");
+    x.on_next(2);
+    assert((out == std::vector<std::string>{"a11", "b11", "b12"}));
+    x.on_completed();
+    y.on_completed();
+    z.on_next(20);
+    assert(out.back() == "b22" && !done);
+    z.on_completed();
+    assert(done);
+  }
+
+  // f runs outside any lock: an update from inside f is folded into one more recomputation
+  {
+    subject<int> x, y;
+    std::vector<int> out;
+    auto s = combine_latest([&](int i, int j){
+                              if (i == 1) x.on_next(2); // re-entrant update
+                              return i * 10 + j;
+                            }, x.as_observable(), y.as_observable())
+               .subscribe([&](int v){ out.push_back(v); });
+    y.on_next(0);
+    x.on_next(1);
+    assert((out == std::vector<int>{10, 20}));
+  }
+
+  // coalesce_on: a burst of updates within one executor turn -> one recomputation
+  {
+    strand turn;
+    std::vector<subject<int>> in(12);
+    int calls = 0;
+    std::vector<int> out;
+    auto obs = [&](int i){ return in[i].as_observable(); };
+    auto s = combine_latest(coalesce_on(turn),
+                            [&](int v0, int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8, int v9, int v10, int v11){
+                              ++calls;
+                              return v0 + v1 + v2 + v3 + v4 + v5 + v6 + v7 + v8 + v9 + v10 + v11;
+                            },
+                            obs(0), obs(1), obs(2), obs(3), obs(4), obs(5),
+                            obs(6), obs(7), obs(8), obs(9), obs(10), obs(11))
+               .subscribe([&](int v){ out.push_back(v); });
+    for (int round = 1; round <= 3; ++round)
+      for (auto& src : in) src.on_next(round);
+    assert(calls == 0 && "nothing is computed before the executor runs");
+    turn.drain();
+    assert(calls == 1 && (out == std::vector<int>{36}) && "36 updates, one recomputation with the newest values");
+    in[5].on_next(100);
+    in[5].on_next(10);
+    turn.drain();
+    assert(calls == 2 && out.back() == 43);
+  }
+
+  // Updates from several threads: the last emission sees the final values
+  {
+    std::vector<subject<int>> in(4);
+    std::atomic<int> last{-1};
+    auto s = combine_latest([](int w, int x, int y, int z){ return w + x + y + z; },
+                            in[0].as_observable(), in[1].as_observable(),
+                            in[2].as_observable(), in[3].as_observable())
+               .subscribe([&](int v){ last = v; });
+    std::vector<std::thread> ths;
+    for (int t = 0; t < 4; ++t)
+      ths.emplace_back([&, t]{ for (int i = 0; i <= 5000; ++i) in[t].on_next(i); });
+    for (auto& th : ths) th.join();
+    assert(last == 20000);
+  }
+
+  // Errors: from a source and from f
+  {
+    subject<int> x, y;
+    bool err = false;
+    int n = 0;
+    auto s = combine_latest([](int i, int j){ if (i < 0) throw std::runtime_error("f"); return i + j; },
+                            x.as_observable(), y.as_observable())
+               .subscribe([&](int){ ++n; }, [&](std::exception_ptr){ err = true; });
+    x.on_next(1);
+    y.on_next(1);
+    x.on_next(-1);
+    assert(err && n == 1);
+    y.on_next(2);
+    assert(n == 1);
+  }
+  {
+    subject<int> x, y;
+    bool err = false;
+    auto s = combine_latest([](int i, int j){ return i + j; }, x.as_observable(), y.as_observable())
+               .subscribe([](int){}, [&](std::exception_ptr){ err = true; });
+    y.on_error(std::make_exception_ptr(std::runtime_error("src")));
+    assert(err);
+  }
   std::cout << "[combine_latest_tests] OK\n";
   return 0;
 }
@@ -1,11 +1,18 @@
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <stdexcept>
 
 #include <pulse/pulse.hpp>
 
 using namespace pulse;
+using namespace std::chrono_literals;
 
 // synchronous range source
 static observable<int> range(int a, int b) {
@@ -16,6 +23,26 @@ static observable<int> range(int a, int b) {
   });
 }
 
+// Inner sources driven by the test: emit(i, v), finish(i), fail(i)
+struct Inners {
+  struct handle {
+    std::function<void(int)> on_next;
+    std::function<void(std::exception_ptr)> on_err;
+    std::function<void()> on_done;
+  };
+  std::vector<std::shared_ptr<handle>> started;
+
+  observable<int> make() {
+    return observable<int>::create([this](auto on_next, auto on_err, auto on_done){
+      started.push_back(std::make_shared<handle>(handle{on_next, on_err, on_done}));
+      return subscription{};
+    });
+  }
+  void emit(int i, int v) { started[i]->on_next(v); }
+  void finish(int i) { started[i]->on_done(); }
+  void fail(int i) { started[i]->on_err(std::make_exception_ptr(std::runtime_error("inner"))); }
+};
+
 int main() {
   // 1) Base order: strict concatenation
   {
@@ -100,6 +127,118 @@ int main() {
     assert(got == exp && "unsubscribe should stop further emissions");
   }
 
+  // 4) concat_map_eager: prefetched inners are subscribed at once, output stays in order
+  {
+    Inners in;
+    std::vector<int> got;
+    bool done = false;
+    auto sub = (range(1, 4) | concat_map_eager([&](int){ return in.make(); }, 3))
+                 .subscribe([&](int v){ got.push_back(v); }, nullptr, [&]{ done = true; });
+    assert(in.started.size() == 3 && "prefetch = 3 inners subscribed up front");
+
+    in.emit(1, 21);
+    in.emit(2, 31);
+    in.finish(2);
+    assert(got.empty() && "later inners are buffered");
+    in.emit(0, 11);
+    assert((got == std::vector<int>{11}) && "the oldest inner emits directly");
+    in.finish(0);
+    assert((got == std::vector<int>{11, 21}));
+    assert(in.started.size() == 4 && "a finished inner frees a slot");
+    in.finish(1);
+    assert((got == std::vector<int>{11, 21, 31}));
+    in.emit(3, 41);
+    assert(!done);
+    in.finish(3);
+    assert((got == std::vector<int>{11, 21, 31, 41}) && done);
+  }
+
+  // 5) concat_map_eager: an inner error arrives after the output of earlier inners
+  {
+    Inners in;
+    std::vector<int> got;
+    bool err = false;
+    auto sub = (range(1, 3) | concat_map_eager([&](int){ return in.make(); }, 3))
+                 .subscribe([&](int v){ got.push_back(v); }, [&](std::exception_ptr){ err = true; });
+    in.fail(1);
+    assert(!err && "not before the oldest inner is done");
+    in.emit(0, 1);
+    in.finish(0);
+    assert(err && (got == std::vector<int>{1}));
+    in.emit(2, 3);
+    assert(got.size() == 1);
+  }
+
+  // 6) concat_map_eager: inner latencies overlap (asynchronous inners on a pool)
+  {
+    thread_pool pool{4};
+    std::atomic<int> running{0}, peak{0};
+    std::mutex m;
+    std::vector<int> got;
+    std::atomic<bool> done{false};
+    auto sub = (range(1, 8) | concat_map_eager([&](int x){
+                  return observable<int>::create([&, x](auto on_next, auto, auto on_done){
+                    pool.post([&, x, on_next, on_done]{
+                      int now = ++running;
+                      int p = peak.load();
+                      while (now > p && !peak.compare_exchange_weak(p, now)) {}
+                      std::this_thread::sleep_for(std::chrono::milliseconds(9 - x)); // later ones finish first
+                      --running;
+                      on_next(x * 10);
+                      on_next(x * 10 + 1);
+                      on_done();
+                    });
+                    return subscription{};
+                  });
+                }, 4))
+                 .subscribe([&](int v){ std::lock_guard<std::mutex> l(m); got.push_back(v); },
+                            nullptr, [&]{ done = true; });
+    for (int i = 0; i < 2000 && !done; ++i) std::this_thread::sleep_for(1ms);
+    std::lock_guard<std::mutex> l(m);
+    assert(done);
+    std::vector<int> exp;
+    for (int x = 1; x <= 8; ++x) { exp.push_back(x * 10); exp.push_back(x * 10 + 1); }
+    assert(got == exp);
+    assert(peak > 1 && peak <= 4);
+  }
+
+  // 7) concat_map_eager: synchronous inners and a long source, no recursion
+  {
+    std::vector<int> in(100000);
+    for (int i = 0; i < 100000; ++i) in[i] = i;
+    long long sum = 0;
+    bool done = false;
+    auto sub = (from_range(in) | concat_map_eager([](int x){ return range(x, x); }, 4))
+                 .subscribe([&](int v){ sum += v; }, nullptr, [&]{ done = true; });
+    assert(done && sum == 4999950000LL);
+  }
+
+  // 8) concat_map_eager: downstream demand
+  {
+    auto d = std::make_shared<demand>();
+    std::vector<int> got;
+    bool done = false;
+    auto sub = (range(1, 3) | concat_map_eager([](int x){ return range(x * 10, x * 10 + 1); }, 2))
+                 .subscribe([&](int v){ got.push_back(v); }, nullptr, [&]{ done = true; }, d);
+    assert(got.empty());
+    d->request(3);
+    assert((got == std::vector<int>{10, 11, 20}));
+    d->request(10);
+    assert((got == std::vector<int>{10, 11, 20, 21, 30, 31}) && done);
+  }
+
+  // 9) concat_map_eager: an outer source failing inside subscribe() is cancelled right away
+  {
+    bool err = false, up_cancelled = false;
+    auto outer = observable<int>::create([&](auto, auto on_err, auto){
+      on_err(std::make_exception_ptr(std::runtime_error("boom")));
+      return subscription([&]{ up_cancelled = true; });
+    });
+    auto sub = (outer | concat_map_eager([](int x){ return range(x, x); }, 2))
+                 .subscribe([](int){}, [&](std::exception_ptr){ err = true; });
+    assert(err && up_cancelled && "the late outer subscription is not kept");
+  }
+
   std::cout << "[concat_map_tests] OK\n";
   return 0;
 }
@@ -0,0 +1,201 @@
+#include <cassert>
+#include <atomic>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <pulse/pulse.hpp>
+
+using namespace pulse;
+
+// strand that counts tasks posted but not yet run
+struct tracking_strand : executor {
+  using executor::post;
+  strand inner;
+  int in_flight{0};
+  int max_in_flight{0};
+  void post(std::function<void()> f) override {
+    ++in_flight;
+    if (in_flight > max_in_flight) max_in_flight = in_flight;
+    inner.post([this, f = std::move(f)]{ --in_flight; f(); });
+  }
+};
+
+static std::vector<int> iota(int from, int to) {
+  std::vector<int> v;
+  for (int i = from; i <= to; ++i) v.push_back(i);
+  return v;
+}
+
+int main() {
+  // 1) from_range honors credit; completion needs none
+  {
+    auto d = std::make_shared<demand>();
+    std::vector<int> got;
+    bool done = false;
+    auto sub = from_range(iota(1, 5)).subscribe([&](int v){ got.push_back(v); }, {}, [&]{ done = true; }, d);
+    assert(got.empty());
+    d->request(3);
+    assert((got == std::vector<int>{1, 2, 3}) && !done);
+    d->request(10);
+    assert(got.size() == 5 && done);
+
+    // without demand: plain cold source
+    std::vector<int> all;
+    auto s2 = from_range(iota(1, 4)).subscribe([&](int v){ all.push_back(v); });
+    assert((all == std::vector<int>{1, 2, 3, 4}));
+  }
+
+  // 2) map/filter/take propagate demand; filter returns the credit of dropped values
+  {
+    auto d = std::make_shared<demand>();
+    int pulled = 0;
+    std::vector<int> got;
+    auto src = from_range(iota(1, 100)) | map([&](int v){ ++pulled; return v; })
+             | filter([](int v){ return v % 2 == 0; }) | take(50);
+    auto sub = src.subscribe([&](int v){ got.push_back(v); }, {}, {}, d);
+    d->request(2);
+    assert((got == std::vector<int>{2, 4}));
+    assert(pulled == 4 && "source must not run ahead of demand");
+  }
+
+  // 3) Request from inside on_next (one at a time, lossless)
+  {
+    auto d = std::make_shared<demand>();
+    std::vector<int> got;
+    auto sub = from_range(iota(1, 1000)).subscribe(
+      [&](int v){ got.push_back(v); d->request(1); }, {}, {}, d);
+    d->request(1);
+    assert(got.size() == 1000 && got.back() == 1000);
+  }
+
+  // 4) zip: both sources are pulled only as far as requested
+  {
+    auto d = std::make_shared<demand>();
+    int pulled_a = 0, pulled_b = 0;
+    auto a = from_range(iota(1, 100)) | map([&](int v){ ++pulled_a; return v; });
+    auto b = from_range(iota(101, 200)) | map([&](int v){ ++pulled_b; return v; });
+    std::vector<int> got;
+    auto sub = zip(a, b, [](int x, int y){ return x + y; })
+                 .subscribe([&](int v){ got.push_back(v); }, {}, {}, d);
+    d->request(3);
+    assert((got == std::vector<int>{102, 104, 106}));
+    assert(pulled_a == 3 && pulled_b == 3 && "zip queues stay bounded by the credit");
+  }
+
+  // 5) concat_map: outer pulled one at a time, inner gets the downstream credit
+  {
+    auto d = std::make_shared<demand>();
+    int outer_pulled = 0;
+    auto src = from_range(iota(1, 10)) | map([&](int v){ ++outer_pulled; return v; })
+             | concat_map([](int x){ return from_range(std::vector<int>{x, x}); });
+    std::vector<int> got;
+    auto sub = src.subscribe([&](int v){ got.push_back(v); }, {}, {}, d);
+    d->request(3);
+    assert((got == std::vector<int>{1, 1, 2}));
+    assert(outer_pulled == 2);
+  }
+
+  // 6) merge: both sources share one credit
+  {
+    auto d = std::make_shared<demand>();
+    std::vector<int> got;
+    auto sub = merge(from_range(iota(1, 10)), from_range(iota(11, 20)))
+                 .subscribe([&](int v){ got.push_back(v); }, {}, {}, d);
+    d->request(4);
+    assert(got.size() == 4);
+    d->request(demand::unbounded);
+    assert(got.size() == 20);
+  }
+
+  // 7) observe_on: the executor queue never holds more than the credit
+  {
+    tracking_strand ex;
+    auto d = std::make_shared<demand>();
+    int got = 0;
+    bool done = false;
+    auto sub = (from_range(iota(1, 1000)) | observe_on(ex))
+                 .subscribe([&](int){ ++got; d->request(1); }, {}, [&]{ done = true; }, d);
+    d->request(8);
+    ex.inner.drain(); // runs until the queue is empty (tasks request more as they go)
+    assert(got == 1000 && done);
+    assert(ex.max_in_flight <= 9 && "queue bounded by credit (+ the completion task)");
+  }
+
+  // 8) subject: per-subscriber gate, demand() for producers
+  {
+    subject<int> s;
+    auto d = std::make_shared<demand>();
+    std::vector<int> slow, fast;
+    auto s1 = s.as_observable().subscribe([&](int v){ slow.push_back(v); }, {}, {}, d);
+    auto s2 = s.as_observable().subscribe([&](int v){ fast.push_back(v); });
+    assert(s.demand() == 0);
+    d->request(2);
+    assert(s.demand() == 2);
+    for (int i = 1; i <= 5; ++i) s.on_next(i);
+    assert((slow == std::vector<int>{1, 2}) && fast.size() == 5);
+    assert(s.demand() == 0);
+    d->request(10);
+    assert((slow == std::vector<int>{1, 2, 3, 4, 5}) && "buffered values delivered, none lost");
+    assert(s.demand() == 7);
+  }
+
+  // 9) topic as observable with demand
+  {
+    inline_executor ui;
+    topic<int> t;
+    auto d = std::make_shared<demand>();
+    std::vector<int> got;
+    auto sub = as_observable(t, ui).subscribe([&](int v){ got.push_back(v); }, {}, {}, d);
+    t.publish(1);
+    t.publish(2);
+    assert(got.empty());
+    d->request(1);
+    assert((got == std::vector<int>{1}));
+    d->request(5);
+    assert((got == std::vector<int>{1, 2}));
+  }
+
+  // 10) Stalled consumer: the gate never holds more than its capacity beyond the credit
+  {
+    subject<int> s{flow_options{.capacity = 16}};
+    auto d = std::make_shared<demand>();
+    std::vector<int> got;
+    auto sub = s.as_observable().subscribe([&](int v){ got.push_back(v); }, {}, {}, d);
+    d->request(1);
+    for (int i = 0; i < 100000; ++i) s.on_next(i);
+    assert((got == std::vector<int>{0}));
+    assert(s.demand() == 0);
+    d->request(demand::unbounded);
+    assert(got.size() == 17 && got.back() == 16 && "drop: the first 16 waited, the rest was dropped");
+  }
+  {
+    inline_executor ui;
+    topic<int> t;
+    auto d = std::make_shared<demand>();
+    std::vector<int> got;
+    auto sub = as_observable(t, ui, flow_options{.capacity = 4, .overflow = flow_overflow::latest})
+                 .subscribe([&](int v){ got.push_back(v); }, {}, {}, d);
+    for (int i = 0; i < 1000; ++i) t.publish(i);
+    d->request(100);
+    assert((got == std::vector<int>{996, 997, 998, 999}) && "latest: the newest values are kept");
+  }
+  {
+    subject<int> s{flow_options{.capacity = 4, .overflow = flow_overflow::error}};
+    auto d = std::make_shared<demand>();
+    std::vector<int> got;
+    bool err = false;
+    auto sub = s.as_observable().subscribe([&](int v){ got.push_back(v); },
+                                           [&](std::exception_ptr){ err = true; }, {}, d);
+    for (int i = 0; i < 4; ++i) s.on_next(i);
+    assert(!err);
+    s.on_next(4);
+    assert(err && got.empty() && "error: the subscriber fails without waiting for credit");
+    d->request(10);
+    assert(got.empty());
+  }
+
+  std::cout << "[flow_control_tests] OK\n";
+  return 0;
+}
@@ -0,0 +1,193 @@
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <pulse/pulse.hpp>
+
+using namespace pulse;
+
+// Runs f on a worker of the pool and waits for it
+template <class F>
+static void run_on(thread_pool& pool, F f) {
+  std::promise<void> done;
+  pool.post([&]{ f(); done.set_value(); });
+  done.get_future().wait();
+}
+
+int main() {
+  // 1) running_in_this_thread()
+  {
+    inline_executor ui;
+    assert(ui.running_in_this_thread());
+
+    thread_pool pool{1};
+    assert(!pool.running_in_this_thread() && "main thread is not a pool worker");
+    bool on_worker = false;
+    run_on(pool, [&]{ on_worker = pool.running_in_this_thread(); });
+    assert(on_worker && "pool worker must be recognized");
+
+    thread_pool other{1};
+    bool foreign = true;
+    run_on(pool, [&]{ foreign = other.running_in_this_thread(); });
+    assert(!foreign && "a worker of another pool is not 'current'");
+
+    strand st;
+    bool in_drain = false;
+    st.post([&]{ in_drain = st.running_in_this_thread(); });
+    assert(!st.running_in_this_thread());
+    st.drain();
+    assert(in_drain && "strand is current while draining");
+  }
+
+  // 2) observe_on(pool, inline_if_current): same-pool hop is delivered synchronously
+  {
+    thread_pool pool{1};
+    subject<int> s;
+    std::vector<int> got;
+    auto sub = (s.as_observable() | observe_on(pool, inline_if_current))
+                 .subscribe([&](int v){ got.push_back(v); });
+
+    std::size_t seen_inside = 0;
+    run_on(pool, [&]{
+      s.on_next(1);
+      s.on_next(2);
+      seen_inside = got.size(); // delivered before on_next returned
+    });
+    assert(seen_inside == 2 && "inline_if_current must skip the queue on the same executor");
+    assert((got == std::vector<int>{1, 2}));
+  }
+
+  // 3) Default observe_on always goes through the queue
+  {
+    thread_pool pool{1};
+    subject<int> s;
+    std::atomic<int> got{0};
+    auto sub = (s.as_observable() | observe_on(pool)).subscribe([&](int){ got.fetch_add(1); });
+
+    int seen_inside = -1;
+    run_on(pool, [&]{
+      s.on_next(1);
+      seen_inside = got.load();
+    });
+    run_on(pool, []{}); // flush
+    assert(seen_inside == 0 && "without the flag delivery is posted");
+    assert(got.load() == 1);
+  }
+
+  // 4) Order is preserved when earlier events are still queued
+  {
+    thread_pool pool{1};
+    subject<int> s;
+    std::vector<int> got;
+    auto sub = (s.as_observable() | observe_on(pool, inline_if_current))
+                 .subscribe([&](int v){ got.push_back(v); });
+
+    std::promise<void> gate;
+    auto gf = gate.get_future().share();
+    pool.post([gf]{ gf.wait(); });
+    pool.post([&]{ s.on_next(2); }); // runs on the worker while 1 is still queued
+    s.on_next(1);                    // from main: queued behind the gate and the emitter
+    gate.set_value();
+    run_on(pool, []{});
+    run_on(pool, []{});
+    assert((got == std::vector<int>{1, 2}) && "inline delivery must not overtake queued events");
+  }
+
+  // 4b) Several workers: a queued event still being delivered on one worker is
+  //     neither overtaken nor run alongside by an emission on another worker
+  {
+    thread_pool pool{4};
+    subject<int> s;
+    std::vector<int> got;
+    std::atomic<int> in_flight{0}, overlaps{0}, delivered{0};
+    std::atomic<bool> first_started{false};
+    auto sub = (s.as_observable() | observe_on(pool, inline_if_current))
+                 .subscribe([&](int v){
+                   if (in_flight.fetch_add(1) != 0) overlaps.fetch_add(1);
+                   if (v == 0) {
+                     first_started.store(true);
+                     std::this_thread::sleep_for(std::chrono::milliseconds(30));
+                   }
+                   got.push_back(v);
+                   in_flight.fetch_sub(1);
+                   delivered.fetch_add(1, std::memory_order_release);
+                 });
+
+    s.on_next(0); // from main: posted, slow to deliver
+    while (!first_started.load()) std::this_thread::yield();
+    run_on(pool, [&]{ for (int i = 1; i <= 3; ++i) s.on_next(i); }); // another worker
+    for (int i = 0; i < 2000 && delivered.load(std::memory_order_acquire) < 4; ++i)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    assert(delivered.load(std::memory_order_acquire) == 4);
+    assert(overlaps.load() == 0 && "on_next must never run concurrently");
+    assert((got == std::vector<int>{0, 1, 2, 3}) && "order is kept across workers");
+  }
+
+  // 4c) Several workers emitting at once: only one of them takes the inline
+  //     slot, the others queue behind it
+  {
+    thread_pool pool{4};
+    subject<int> s;
+    std::atomic<int> in_flight{0}, overlaps{0}, delivered{0};
+    std::promise<void> all;
+    auto sub = (s.as_observable() | observe_on(pool, inline_if_current))
+                 .subscribe([&](int){
+                   if (in_flight.fetch_add(1) != 0) overlaps.fetch_add(1);
+                   std::this_thread::yield();
+                   in_flight.fetch_sub(1);
+                   if (delivered.fetch_add(1, std::memory_order_acq_rel) + 1 == 2000) all.set_value();
+                 });
+
+    for (int i = 0; i < 2000; ++i)
+      pool.post([&s, i]{ s.on_next(i); });
+    all.get_future().wait(); // under load this can take a while: no fixed deadline
+    assert(delivered.load(std::memory_order_acquire) == 2000);
+    assert(overlaps.load() == 0 && "concurrent emitters must not deliver side by side");
+  }
+
+  // 4d) A delivery that throws on the inline path gives the slot back
+  {
+    thread_pool pool{1};
+    subject<int> s;
+    std::vector<int> got;
+    auto sub = (s.as_observable() | observe_on(pool, inline_if_current))
+                 .subscribe([&](int v){
+                   if (v == 1) throw std::runtime_error("boom");
+                   got.push_back(v);
+                 });
+
+    bool thrown = false;
+    run_on(pool, [&]{
+      try { s.on_next(1); } catch (const std::runtime_error&) { thrown = true; }
+      s.on_next(2);
+    });
+    assert(thrown && (got == std::vector<int>{2}) && "the slot is free again after a throw");
+  }
+
+  // 5) topic: opt-in inline delivery when publishing from the subscriber's executor
+  {
+    thread_pool pool{1};
+    topic<int> t;
+    std::vector<int> got;
+    auto sub = t.subscribe(pool, priority{0}, bp_none{}, [&](int v){ got.push_back(v); }, inline_if_current);
+
+    std::size_t seen_inside = 0;
+    run_on(pool, [&]{
+      t.publish(7);
+      seen_inside = got.size();
+    });
+    assert(seen_inside == 1 && "topic: inline_if_current delivers inside publish()");
+
+    t.publish(8); // from main: posted
+    run_on(pool, []{});
+    assert((got == std::vector<int>{7, 8}));
+  }
+
+  std::cout << "[inline_if_current_tests] OK\n";
+  return 0;
+}
@@ -0,0 +1,144 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <pulse/pulse.hpp>
+#include <iostream>
+
+using namespace pulse;
+using namespace std::chrono_literals;
+
+int main() {
+  // Concurrent subscribers of one key share one call; the key is evicted after it
+  {
+    keyed_share<std::string, int> calls_by_key;
+    std::map<std::string, std::shared_ptr<subject<int>>> backend;
+    int started = 0;
+    auto call = [&](const std::string& k){
+      return calls_by_key.get(k, [&, k]{
+        ++started;
+        backend[k] = std::make_shared<subject<int>>();
+        return backend[k]->as_observable();
+      });
+    };
+
+    std::vector<int> a, b, c;
+    int done = 0;
+    auto s1 = call("x").subscribe([&](int v){ a.push_back(v); }, nullptr, [&]{ ++done; });
+    auto s2 = call("x").subscribe([&](int v){ b.push_back(v); }, nullptr, [&]{ ++done; });
+    auto s3 = call("y").subscribe([&](int v){ c.push_back(v); });
+    assert(started == 2 && calls_by_key.size() == 2);
+
+    backend["x"]->on_next(1);
+    backend["x"]->on_completed();
+    assert((a == std::vector<int>{1}) && (b == std::vector<int>{1}) && done == 2);
+    assert(c.empty() && calls_by_key.size() == 1 && "x evicted after completion");
+
+    auto s4 = call("x").subscribe([](int){});
+    assert(started == 3 && "a new call after eviction");
+  }
+
+  // A late joiner gets the answer the call already produced
+  {
+    keyed_share<int, std::string> share;
+    subject<std::string> backend;
+    std::vector<std::string> early, late;
+    bool late_done = false;
+    auto make = [&]{ return backend.as_observable(); };
+    auto s1 = share.get(1, make).subscribe([&](const std::string& v){ early.push_back(v); });
+    backend.on_next("answer");
+    auto s2 = share.get(1, make).subscribe([&](const std::string& v){ late.push_back(v); }, nullptr,
+                                           [&]{ late_done = true; });
+    assert((late == std::vector<std::string>{"answer"}) && "replayed to the joiner");
+    backend.on_completed();
+    assert(late_done && early.size() == 1);
+  }
+
+  // When every subscriber leaves, the call is cancelled and the key evicted
+  {
+    keyed_share<int, int> share;
+    int started = 0;
+    std::atomic<int> cancelled{0};
+    auto make = [&]{
+      ++started;
+      return observable<int>::create([&](auto, auto, auto){
+        return subscription([&]{ ++cancelled; });
+      });
+    };
+    auto s1 = share.get(7, make).subscribe([](int){});
+    auto s2 = share.get(7, make).subscribe([](int){});
+    s1.reset();
+    assert(cancelled == 0 && share.size() == 1 && "one subscriber is still waiting");
+    s2.reset();
+    assert(cancelled == 1 && share.size() == 0);
+    auto s3 = share.get(7, make).subscribe([](int){});
+    assert(started == 2);
+  }
+
+  // Errors (from the call or thrown by make) reach every subscriber and evict the key
+  {
+    keyed_share<int, int> share;
+    subject<int> backend;
+    int errors = 0;
+    auto s1 = share.get(1, [&]{ return backend.as_observable(); }).subscribe([](int){}, [&](std::exception_ptr){ ++errors; });
+    auto s2 = share.get(1, [&]{ return backend.as_observable(); }).subscribe([](int){}, [&](std::exception_ptr){ ++errors; });
+    backend.on_error(std::make_exception_ptr(std::runtime_error("backend")));
+    assert(errors == 2 && share.size() == 0);
+
+    auto s3 = share.get(2, []() -> observable<int> { throw std::runtime_error("make"); })
+                .subscribe([](int){}, [&](std::exception_ptr){ ++errors; });
+    assert(errors == 3 && share.size() == 0);
+  }
+
+  // A call that answers synchronously is still delivered, and not kept in flight
+  {
+    keyed_share<int, int> share;
+    std::vector<int> got;
+    auto s = share.get(3, []{ return from_range(std::vector<int>{4, 5}); })
+               .subscribe([&](int v){ got.push_back(v); });
+    assert((got == std::vector<int>{4, 5}) && share.size() == 0);
+  }
+
+  // 40 concurrent requests for a popular key start one backend call
+  {
+    thread_pool io{2};
+    std::atomic<int> started{0}, answers{0};
+    auto search = coalesce_by_key<std::string>(
+      [](const std::string& q){ return q; },
+      [&](const std::string& q){
+        return observable<std::string>::create([&, q](auto on_next, auto, auto on_done){
+          ++started;
+          auto group = std::make_shared<cancel_group>();
+          io.post([q, on_next, on_done]{
+            std::this_thread::sleep_for(50ms);
+            on_next("[result] " + q);
+            on_done();
+          }, group);
+          return make_subscription(group);
+        });
+      });
+
+    std::vector<std::thread> users;
+    std::vector<subscription> subs(40);
+    for (int i = 0; i < 40; ++i) {
+      users.emplace_back([&, i]{
+        subs[i] = search(std::string("pulse")).subscribe([&](const std::string& r){
+          assert(r == "[result] pulse");
+          ++answers;
+        });
+      });
+    }
+    for (auto& u : users) u.join();
+    const auto until = std::chrono::steady_clock::now() + 2s;
+    while (answers < 40 && std::chrono::steady_clock::now() < until) std::this_thread::sleep_for(1ms);
+    assert(answers == 40 && started == 1);
+  }
+
+  std::cout << "keyed_share tests passed\n";
+  return 0;
+}
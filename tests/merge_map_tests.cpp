@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <pulse/pulse.hpp>
+
+using namespace pulse;
+using namespace std::chrono_literals;
+
+// Inner source completed from the test: x -> emits x*10 on finish(x)
+struct Pending {
+  std::vector<std::function<void()>> finish_fns;
+  std::vector<int> started;
+
+  observable<int> make(int x) {
+    return observable<int>::create([this, x](auto on_next, auto, auto on_done){
+      started.push_back(x);
+      finish_fns.push_back([=]{ if (on_next) on_next(x * 10); if (on_done) on_done(); });
+      return subscription{};
+    });
+  }
+};
+
+int main() {
+  // 1) At most k inner observables at once, the rest wait
+  {
+    Pending p;
+    std::vector<int> got;
+    bool done = false;
+    auto sub = (from_range(std::vector<int>{1, 2, 3, 4, 5}) | merge_map([&](int x){ return p.make(x); }, 2))
+                 .subscribe([&](int v){ got.push_back(v); }, nullptr, [&]{ done = true; });
+
+    assert((p.started == std::vector<int>{1, 2}) && "merge_map: k = 2 concurrent inners");
+    p.finish_fns[1](); // 2 finishes first
+    assert((p.started == std::vector<int>{1, 2, 3}));
+    p.finish_fns[0]();
+    p.finish_fns[2]();
+    assert((p.started == std::vector<int>{1, 2, 3, 4, 5}));
+    assert(!done);
+    p.finish_fns[4]();
+    p.finish_fns[3]();
+    assert((got == std::vector<int>{20, 10, 30, 50, 40}) && "values in completion order");
+    assert(done && "completes after the outer source and every inner one");
+  }
+
+  // 2) Synchronous inner observables: no recursion, everything in order
+  {
+    std::vector<int> in(100000);
+    for (int i = 0; i < 100000; ++i) in[i] = i;
+    long long sum = 0;
+    bool done = false;
+    auto sub = (from_range(in) | merge_map([](int x){
+                  return observable<int>::create([x](auto on_next, auto, auto on_done){
+                    on_next(x);
+                    on_done();
+                    return subscription{};
+                  });
+                }, 4))
+                 .subscribe([&](int v){ sum += v; }, nullptr, [&]{ done = true; });
+    assert(done && sum == 4999950000LL);
+  }
+
+  // 3) An inner error cancels the outer source and the other inners
+  {
+    Pending p;
+    std::vector<int> got;
+    bool err = false;
+    subject<int> outer;
+    auto sub = (outer.as_observable() | merge_map([&](int x){
+                  if (x == 3)
+                    return observable<int>::create([](auto, auto on_err, auto){
+                      on_err(std::make_exception_ptr(std::runtime_error("boom")));
+                      return subscription{};
+                    });
+                  return p.make(x);
+                }, 4))
+                 .subscribe([&](int v){ got.push_back(v); }, [&](std::exception_ptr){ err = true; });
+    outer.on_next(1);
+    outer.on_next(2);
+    outer.on_next(3);
+    assert(err);
+    p.finish_fns[0]();
+    outer.on_next(4);
+    assert(got.empty() && p.started.size() == 2 && "nothing gets through after the error");
+  }
+
+  // 3b) An outer source failing inside subscribe() is cancelled right away
+  {
+    bool err = false, up_cancelled = false;
+    auto outer = observable<int>::create([&](auto, auto on_err, auto){
+      on_err(std::make_exception_ptr(std::runtime_error("boom")));
+      return subscription([&]{ up_cancelled = true; });
+    });
+    auto sub = (outer | merge_map([](int x){ return from_range(std::vector<int>{x}); }, 2))
+                 .subscribe([](int){}, [&](std::exception_ptr){ err = true; });
+    assert(err && up_cancelled && "the late outer subscription is not kept");
+  }
+
+  // 4) f throwing is an error too
+  {
+    bool err = false;
+    auto sub = (from_range(std::vector<int>{1, 2}) | merge_map([](int) -> observable<int> {
+                  throw std::runtime_error("f");
+                }, 2))
+                 .subscribe([](int){}, [&](std::exception_ptr){ err = true; });
+    assert(err);
+  }
+
+  // 5) Bounded outer demand: a demand-aware outer source is pulled k at a time
+  {
+    Pending p;
+    std::vector<int> in(1000);
+    for (int i = 0; i < 1000; ++i) in[i] = i;
+    auto sub = (from_range(in) | merge_map([&](int x){ return p.make(x); }, 3))
+                 .subscribe([](int){});
+    assert(p.started.size() == 3 && "only k outer values are requested");
+    p.finish_fns[0]();
+    assert(p.started.size() == 4);
+  }
+
+  // 6) Asynchronous inner work on a pool
+  {
+    thread_pool pool{4};
+    std::atomic<int> running{0}, peak{0}, count{0};
+    std::atomic<bool> done{false};
+    std::vector<int> in(64);
+    for (int i = 0; i < 64; ++i) in[i] = i;
+
+    auto sub = (from_range(in) | merge_map([&](int x){
+                  return observable<int>::create([&, x](auto on_next, auto, auto on_done){
+                    pool.post([&, x, on_next, on_done]{
+                      int now = ++running;
+                      int p = peak.load();
+                      while (now > p && !peak.compare_exchange_weak(p, now)) {}
+                      std::this_thread::sleep_for(1ms);
+                      --running;
+                      on_next(x);
+                      on_done();
+                    });
+                    return subscription{};
+                  });
+                }, 3))
+                 .subscribe([&](int){ ++count; }, nullptr, [&]{ done = true; });
+
+    for (int i = 0; i < 2000 && !done; ++i) std::this_thread::sleep_for(1ms);
+    assert(done && count == 64);
+    assert(peak <= 3 && "never more than k inners in flight");
+  }
+
+  std::cout << "[merge_map_tests] OK\n";
+  return 0;
+}
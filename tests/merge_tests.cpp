@@ -2,6 +2,7 @@
 #include <iostream>
 #include <vector>
 #include <stdexcept>
+#include <memory>
 
 #include <pulse/pulse.hpp>
 
@@ -152,6 +153,97 @@ int main() {
     assert(done && "merge(variadic): must complete");
   }
 
+  // 5) merge_all over a runtime collection: one completion counter, first error wins
+  {
+    std::vector<Manual> ms(50);
+    std::vector<observable<int>> srcs;
+    for (auto& m : ms) srcs.push_back(m.obs);
+
+    std::vector<int> got;
+    bool done = false;
+    auto sub = merge_all(srcs).subscribe(
+      [&](int v){ got.push_back(v); }, nullptr, [&]{ done = true; });
+
+    for (int i = 0; i < 50; ++i) ms[i].emit(i);
+    for (int i = 0; i < 49; ++i) ms[i].done();
+    assert(!done && "merge_all: waits for every source");
+    ms[49].done();
+    assert(done && got.size() == 50);
+
+    bool empty_done = false;
+    auto sub2 = merge_all(std::vector<observable<int>>{}).subscribe(
+      [](int){}, nullptr, [&]{ empty_done = true; });
+    assert(empty_done && "merge_all: an empty collection completes at once");
+
+    std::vector<Manual> es(3);
+    std::vector<int> got3;
+    bool err = false;
+    auto sub3 = merge_all(std::vector<observable<int>>{es[0].obs, es[1].obs, es[2].obs}).subscribe(
+      [&](int v){ got3.push_back(v); }, [&](std::exception_ptr){ err = true; });
+    es[1].fail(std::make_exception_ptr(std::runtime_error("x")));
+    es[0].emit(1);
+    es[2].emit(2);
+    assert(err && got3.empty() && "merge_all: the first error cancels the other sources");
+  }
+
+  // 6) merge_all(round_robin): sources take turns while downstream is busy
+  {
+    Manual A, B;
+    std::vector<int> got;
+    bool done = false;
+    bool first = true;
+    auto sub = merge_all(std::vector<observable<int>>{A.obs, B.obs}, round_robin).subscribe(
+      [&](int v){
+        got.push_back(v);
+        if (first) {
+          first = false;
+          // while the first value is being handled, A floods and B sends two
+          for (int i = 1; i <= 4; ++i) A.emit(i);
+          B.emit(100);
+          B.emit(200);
+          A.done();
+          B.done();
+        }
+      },
+      nullptr,
+      [&]{ done = true; });
+
+    A.emit(0);
+    assert((got == std::vector<int>{0, 1, 100, 2, 200, 3, 4}) && "round_robin: one per source in turn");
+    assert(done && "round_robin: completes after the lanes are drained");
+  }
+
+  // 7) merge_all(round_robin) with flow control: lanes drain as credit arrives
+  {
+    Manual A, B;
+    auto d = std::make_shared<demand>();
+    std::vector<int> got;
+    auto sub = merge_all(std::vector<observable<int>>{A.obs, B.obs}, round_robin).subscribe(
+      [&](int v){ got.push_back(v); }, nullptr, nullptr, d);
+    A.emit(1); A.emit(2); B.emit(10);
+    assert(got.empty());
+    d->request(2);
+    assert((got == std::vector<int>{1, 10}));
+    d->request(5);
+    assert((got == std::vector<int>{1, 10, 2}));
+  }
+
+  // 8) merge_all(round_robin): demand-aware sources are pulled one value per lane
+  {
+    std::vector<int> xs(1000), ys(1000, -1);
+    int pulled = 0;
+    auto counted = [&](std::vector<int> v){
+      return from_range(std::move(v)) | map([&](int x){ ++pulled; return x; });
+    };
+    auto d = std::make_shared<demand>();
+    std::vector<int> got;
+    auto sub = merge_all(std::vector<observable<int>>{counted(xs), counted(ys)}, round_robin).subscribe(
+      [&](int v){ got.push_back(v); }, nullptr, nullptr, d);
+    assert(got.empty() && pulled == 2 && "one value per lane up front");
+    d->request(3);
+    assert((got == std::vector<int>{0, -1, 0}) && pulled == 5 && "lanes refill as they drain");
+  }
+
   std::cout << "[merge_tests] OK\n";
   return 0;
 }
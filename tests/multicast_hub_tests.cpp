@@ -0,0 +1,101 @@
+#include <cassert>
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <pulse/pulse.hpp>
+
+using namespace pulse;
+
+int main() {
+  // 1) Slots are recycled: churn does not grow the table
+  {
+    multicast_hub<int> hub;
+    auto keep = hub.add([](int){}, {}, {});
+    for (int i = 0; i < 10000; ++i) {
+      auto h = hub.add([](int){}, {}, {});
+      assert(hub.remove(h) == 1);
+    }
+    assert(hub.capacity() == 2 && "freed slots must be reused");
+    assert(hub.size() == 1);
+  }
+
+  // 2) Removed subscribers get nothing, the rest keep their order
+  {
+    multicast_hub<int> hub;
+    std::vector<int> got;
+    auto a = hub.add([&](int v){ got.push_back(v); }, {}, {});
+    auto b = hub.add([&](int v){ got.push_back(100 + v); }, {}, {});
+    hub.on_next(1);
+    hub.remove(a);
+    hub.on_next(2);
+    assert((got == std::vector<int>{1, 101, 102}));
+  }
+
+  // 3) A stale handle (dropped by a terminal event) cannot remove a newer subscriber
+  {
+    multicast_hub<int> hub;
+    int done = 0, got = 0;
+    auto old = hub.add({}, {}, [&]{ ++done; });
+    hub.on_completed();
+    assert(done == 1 && hub.empty());
+
+    auto fresh = hub.add([&](int){ ++got; }, {}, {});
+    hub.remove(old); // same slot index, different subscriber
+    hub.on_next(1);
+    assert(got == 1 && hub.size() == 1);
+  }
+
+  // 4) Re-entrancy: subscribing/unsubscribing from inside on_next
+  {
+    multicast_hub<int> hub;
+    std::vector<multicast_hub<int>::handle> added;
+    int late = 0;
+    multicast_hub<int>::handle self;
+    self = hub.add([&](int){
+      added.push_back(hub.add([&](int){ ++late; }, {}, {}));
+      hub.remove(self);
+    }, {}, {});
+    hub.on_next(1);             // adds one, removes itself
+    assert(late == 0 && "a subscriber added during an emission joins from the next one");
+    hub.on_next(2);
+    assert(late == 1 && hub.size() == 1);
+  }
+
+  // 5) Concurrent emit and churn
+  {
+    multicast_hub<int> hub;
+    std::atomic<long> got{0};
+    auto base = hub.add([&](int){ got.fetch_add(1); }, {}, {});
+    std::atomic<bool> stop{false};
+    std::thread churn([&]{
+      while (!stop.load()) {
+        auto h = hub.add([&](int){}, {}, {});
+        hub.remove(h);
+      }
+    });
+    for (int i = 0; i < 100000; ++i) hub.on_next(i);
+    stop = true;
+    churn.join();
+    assert(got.load() == 100000);
+    assert(hub.capacity() <= 2);
+  }
+
+  // 6) share(): long-lived share with churn stays compact and keeps working
+  {
+    subject<int> s;
+    auto shared = share(s.as_observable());
+    int a = 0;
+    auto keep = shared.subscribe([&](int){ ++a; });
+    for (int i = 0; i < 1000; ++i) {
+      auto tmp = shared.subscribe([](int){});
+    }
+    s.on_next(1);
+    assert(a == 1);
+  }
+
+  std::cout << "[multicast_hub_tests] OK\n";
+  return 0;
+}
@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <pulse/pulse.hpp>
+
+using namespace pulse;
+using namespace std::chrono_literals;
+
+static std::vector<int> iota_vec(int n) {
+  std::vector<int> v(n);
+  for (int i = 0; i < n; ++i) v[i] = i;
+  return v;
+}
+
+static void wait_for(const std::atomic<bool>& done) {
+  for (int i = 0; i < 2000 && !done; ++i) std::this_thread::sleep_for(1ms);
+}
+
+int main() {
+  // 1) Ordered: output order equals input order even when later values finish first
+  {
+    thread_pool pool{4};
+    std::mutex m;
+    std::vector<int> got;
+    std::atomic<bool> done{false};
+    auto sub = (from_range(iota_vec(200)) | parallel_map(pool, [](int x){
+                  if (x % 7 == 0) std::this_thread::sleep_for(200us);
+                  return x * 2;
+                }, {.ordered = true, .max_in_flight = 16}))
+                 .subscribe([&](int v){ std::lock_guard<std::mutex> l(m); got.push_back(v); },
+                            nullptr, [&]{ done = true; });
+    wait_for(done);
+    std::lock_guard<std::mutex> l(m);
+    assert(done && got.size() == 200);
+    for (int i = 0; i < 200; ++i) assert(got[i] == i * 2 && "parallel_map: input order kept");
+  }
+
+  // 2) Unordered: results come out as soon as they are ready
+  {
+    thread_pool pool{2};
+    std::mutex m;
+    std::vector<int> got;
+    std::atomic<bool> done{false};
+    auto sub = (from_range(iota_vec(10)) | parallel_map(pool, [](int x){
+                  if (x == 0) std::this_thread::sleep_for(50ms);
+                  return x;
+                }, {.ordered = false}))
+                 .subscribe([&](int v){ std::lock_guard<std::mutex> l(m); got.push_back(v); },
+                            nullptr, [&]{ done = true; });
+    wait_for(done);
+    std::lock_guard<std::mutex> l(m);
+    assert(done && got.size() == 10);
+    assert(got.front() != 0 && got.back() == 0 && "the slow value does not hold up the rest");
+    std::sort(got.begin(), got.end());
+    assert(got == iota_vec(10));
+  }
+
+  // 3) At most max_in_flight values are handed to f, also for sources that ignore demand
+  for (bool flow : {true, false}) {
+    thread_pool pool{8};
+    std::atomic<int> running{0}, peak{0}, count{0};
+    std::atomic<bool> done{false};
+    auto in = iota_vec(100);
+    auto src = flow ? from_range(in)
+                    : observable<int>::create([in](auto on_next, auto, auto on_done){
+                        for (int v : in) on_next(v);
+                        on_done();
+                        return subscription{};
+                      });
+    auto sub = (src | parallel_map(pool, [&](int x){
+                  int now = ++running;
+                  int p = peak.load();
+                  while (now > p && !peak.compare_exchange_weak(p, now)) {}
+                  std::this_thread::sleep_for(200us);
+                  --running;
+                  return x;
+                }, {.max_in_flight = 3}))
+                 .subscribe([&](int){ ++count; }, nullptr, [&]{ done = true; });
+    wait_for(done);
+    assert(done && count == 100);
+    assert(peak <= 3 && "never more than max_in_flight values in f");
+  }
+
+  // 4) f throwing: the error is delivered at the position of its value
+  {
+    thread_pool pool{4};
+    std::mutex m;
+    std::vector<int> got;
+    std::atomic<bool> err{false};
+    auto sub = (from_range(iota_vec(100)) | parallel_map(pool, [](int x){
+                  if (x == 10) throw std::runtime_error("boom");
+                  return x;
+                }))
+                 .subscribe([&](int v){ std::lock_guard<std::mutex> l(m); got.push_back(v); },
+                            [&](std::exception_ptr){ err = true; });
+    wait_for(err);
+    std::this_thread::sleep_for(5ms);
+    std::lock_guard<std::mutex> l(m);
+    assert(err);
+    assert(got == iota_vec(10) && "values before the error, nothing after it");
+  }
+
+  // 5) Downstream demand limits what is pulled from the source
+  {
+    inline_executor ex;
+    int pulled = 0;
+    std::vector<int> got;
+    auto d = std::make_shared<demand>();
+    auto sub = (from_range(iota_vec(100)) | map([&](int x){ ++pulled; return x; })
+                  | parallel_map(ex, [](int x){ return x + 1; }, {.max_in_flight = 8}))
+                 .subscribe([&](int v){ got.push_back(v); }, nullptr, nullptr, d);
+    assert(got.empty() && pulled == 0);
+    d->request(3);
+    assert((got == std::vector<int>{1, 2, 3}) && pulled == 3);
+    d->request(2);
+    assert(got.size() == 5 && pulled == 5);
+  }
+
+  // 6) Synchronous executor and a long source: no recursion, everything in order
+  {
+    inline_executor ex;
+    long long sum = 0;
+    int last = -1;
+    bool ordered = true, done = false;
+    auto sub = (from_range(iota_vec(100000)) | parallel_map(ex, [](int x){ return x; }, {.max_in_flight = 4}))
+                 .subscribe([&](int v){ ordered = ordered && v == last + 1; last = v; sum += v; },
+                            nullptr, [&]{ done = true; });
+    assert(done && ordered && sum == 4999950000LL);
+  }
+
+  // 7) Upstream completion waits for the values still in flight; cancel stops the rest
+  {
+    thread_pool pool{2};
+    std::atomic<int> count{0};
+    std::atomic<bool> done{false};
+    auto sub = (from_range(iota_vec(1000)) | parallel_map(pool, [](int x){
+                  std::this_thread::sleep_for(100us);
+                  return x;
+                }, {.max_in_flight = 4}))
+                 .subscribe([&](int){ ++count; }, nullptr, [&]{ done = true; });
+    std::this_thread::sleep_for(5ms);
+    sub.reset();
+    const int seen = count;
+    std::this_thread::sleep_for(5ms);
+    assert(!done && count <= seen + 4 && count < 1000);
+  }
+
+  // 8) f failing while the source is still inside subscribe(): the source is cancelled
+  {
+    inline_executor ex;
+    bool err = false, up_cancelled = false;
+    auto src = observable<int>::create([&](auto on_next, auto, auto){
+      on_next(1);
+      return subscription([&]{ up_cancelled = true; });
+    });
+    auto sub = (src | parallel_map(ex, [](int) -> int { throw std::runtime_error("boom"); }))
+                 .subscribe([](int){}, [&](std::exception_ptr){ err = true; });
+    assert(err && up_cancelled && "the late upstream subscription is not kept");
+  }
+
+  std::cout << "[parallel_map_tests] OK\n";
+  return 0;
+}
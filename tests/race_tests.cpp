@@ -0,0 +1,159 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <pulse/pulse.hpp>
+#include <iostream>
+
+using namespace pulse;
+using namespace std::chrono_literals;
+
+// Cold source: emits `v` after `latency` on its own thread, then completes
+// (or fails); `cancelled` is raised if the subscription is reset first
+static observable<int> backend(int v, std::chrono::milliseconds latency,
+                               std::shared_ptr<std::atomic<int>> cancelled, bool fail = false) {
+  return observable<int>::create([=](auto on_next, auto on_err, auto on_done){
+    auto group = std::make_shared<cancel_group>();
+    std::thread([=]{
+      std::this_thread::sleep_for(latency);
+      if (group->cancelled()) return;
+      if (fail) { if (on_err) on_err(std::make_exception_ptr(std::runtime_error("backend"))); return; }
+      if (on_next) on_next(v);
+      if (on_done) on_done();
+    }).detach();
+    return subscription([group, cancelled]{
+      if (!group->cancelled()) { group->cancel(); ++*cancelled; }
+    });
+  });
+}
+
+template <class Pred>
+static bool wait_for(Pred p, std::chrono::milliseconds limit = 2000ms) {
+  const auto until = std::chrono::steady_clock::now() + limit;
+  while (!p()) {
+    if (std::chrono::steady_clock::now() > until) return false;
+    std::this_thread::sleep_for(1ms);
+  }
+  return true;
+}
+
+int main() {
+  // race: the first source to emit wins, the rest are cancelled
+  {
+    subject<int> a, b, c;
+    std::vector<int> got;
+    bool done = false;
+    auto sub = race(a.as_observable(), b.as_observable(), c.as_observable())
+                 .subscribe([&](int v){ got.push_back(v); }, nullptr, [&]{ done = true; });
+    b.on_next(2);
+    a.on_next(1);
+    c.on_next(3);
+    b.on_next(22);
+    a.on_completed();
+    assert(!done && "a lost: its completion is not mirrored");
+    b.on_completed();
+    assert((got == std::vector<int>{2, 22}) && done);
+  }
+
+  // race: a synchronous winner keeps the later sources from being subscribed
+  {
+    std::atomic<int> subscribed{0};
+    auto never = observable<int>::create([&](auto, auto, auto){ ++subscribed; return subscription{}; });
+    std::vector<int> got;
+    auto sub = race(from_range(std::vector<int>{7, 8}), never)
+                 .subscribe([&](int v){ got.push_back(v); });
+    assert((got == std::vector<int>{7, 8}) && subscribed == 0);
+  }
+
+  // race: an error counts as the first notification
+  {
+    subject<int> a, b;
+    bool failed = false;
+    std::vector<int> got;
+    auto sub = race(a.as_observable(), b.as_observable())
+                 .subscribe([&](int v){ got.push_back(v); },
+                            [&](std::exception_ptr){ failed = true; });
+    a.on_error(std::make_exception_ptr(std::runtime_error("a")));
+    b.on_next(1);
+    assert(failed && got.empty());
+  }
+
+  // hedge: the first attempt answers in time, no duplicate
+  {
+    auto stats = std::make_shared<hedge_counters>();
+    auto cancelled = std::make_shared<std::atomic<int>>(0);
+    std::atomic<int> calls{0}, got{0};
+    std::atomic<bool> done{false};
+    auto sub = hedge([&]{ ++calls; return backend(1, 1ms, cancelled); }, 200ms, 3, stats)
+                 .subscribe([&](int v){ got = v; }, nullptr, [&]{ done = true; });
+    assert(wait_for([&]{ return done.load(); }));
+    const auto s = stats->snapshot();
+    assert(got == 1 && calls == 1);
+    assert(s.calls == 1 && s.hedged == 0 && s.duplicates == 0 && s.hedge_wins == 0);
+  }
+
+  // hedge: a slow first attempt gets a duplicate, which wins; the first one is cancelled
+  {
+    auto stats = std::make_shared<hedge_counters>();
+    auto cancelled = std::make_shared<std::atomic<int>>(0);
+    std::atomic<int> calls{0}, got{0};
+    std::atomic<bool> done{false};
+    auto sub = hedge([&]{
+                 const int n = ++calls;
+                 return backend(n, n == 1 ? 1000ms : 5ms, cancelled);
+               }, 20ms, 3, stats)
+                 .subscribe([&](int v){ got = v; }, nullptr, [&]{ done = true; });
+    assert(wait_for([&]{ return done.load(); }, 900ms) && "the duplicate answers well before the slow attempt");
+    const auto s = stats->snapshot();
+    assert(got == 2 && calls == 2);
+    assert(*cancelled == 1 && "the slow attempt is cancelled");
+    assert(s.hedged == 1 && s.duplicates == 1 && s.hedge_wins == 1 && s.cancelled == 1);
+  }
+
+  // hedge: a failed attempt starts the next one at once
+  {
+    auto cancelled = std::make_shared<std::atomic<int>>(0);
+    std::atomic<int> calls{0}, got{0};
+    std::atomic<bool> done{false}, failed{false};
+    auto sub = hedge([&]{
+                 const int n = ++calls;
+                 return backend(n, 1ms, cancelled, n == 1);
+               }, 1000ms, 3)
+                 .subscribe([&](int v){ got = v; }, [&](std::exception_ptr){ failed = true; },
+                            [&]{ done = true; });
+    assert(wait_for([&]{ return done.load(); }, 500ms) && "no need to wait for the delay");
+    assert(got == 2 && !failed);
+  }
+
+  // hedge: the error is delivered once every attempt has failed
+  {
+    auto cancelled = std::make_shared<std::atomic<int>>(0);
+    std::atomic<int> calls{0}, errors{0};
+    auto sub = hedge([&]{ ++calls; return backend(0, 1ms, cancelled, true); }, 5ms, 3)
+                 .subscribe([](int){}, [&](std::exception_ptr){ ++errors; });
+    assert(wait_for([&]{ return errors.load() == 1; }));
+    std::this_thread::sleep_for(30ms);
+    assert(calls == 3 && errors == 1);
+  }
+
+  // hedge: unsubscribing cancels every attempt and stops further duplicates
+  {
+    auto cancelled = std::make_shared<std::atomic<int>>(0);
+    std::atomic<int> calls{0}, got{0};
+    auto sub = hedge([&]{ ++calls; return backend(1, 1000ms, cancelled); }, 10ms, 4)
+                 .subscribe([&](int){ ++got; });
+    assert(wait_for([&]{ return calls.load() >= 2; }));
+    sub.reset();
+    const int started = calls;
+    std::this_thread::sleep_for(50ms);
+    assert(calls == started && *cancelled == started && got == 0);
+  }
+
+  std::cout << "race tests passed\n";
+  return 0;
+}
@@ -0,0 +1,121 @@
+#include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <pulse/pulse.hpp>
+#include <pulse/core/spill_queue.hpp>
+
+#if !PULSE_HAS_SPILL
+int main() {
+  std::cout << "[spill_tests] skipped (no POSIX mmap)\n";
+  return 0;
+}
+#else
+using namespace pulse;
+namespace fs = std::filesystem;
+
+// Length is implied by the record: the string is stored as is
+struct string_codec {
+  void encode(const std::string& v, std::string& out) const { out.append(v); }
+  std::string decode(std::string_view bytes) const { return std::string(bytes); }
+};
+
+static std::size_t files_in(const fs::path& dir) {
+  std::size_t n = 0;
+  for (auto& e : fs::directory_iterator(dir)) { (void)e; ++n; }
+  return n;
+}
+
+int main() {
+  const fs::path dir = fs::temp_directory_path() / ("pulse_spill_tests_" + std::to_string(::getpid()));
+  fs::remove_all(dir);
+  fs::create_directories(dir);
+
+  // --- spill_queue: FIFO across segments, drained segments are deleted ---
+  {
+    spill_queue<std::uint64_t> q(dir, 4096); // ~340 records per segment
+    for (std::uint64_t i = 0; i < 2000; ++i) q.push(i);
+    assert(q.size() == 2000);
+    const std::size_t segs = q.segments();
+    assert(segs > 4 && files_in(dir) == segs);
+
+    for (std::uint64_t i = 0; i < 1000; ++i) assert(*q.pop() == i);
+    assert(files_in(dir) < segs && "read segments are removed");
+
+    q.push(2000); // appends behind the backlog
+    for (std::uint64_t i = 1000; i <= 2000; ++i) assert(*q.pop() == i);
+    assert(!q.pop() && q.empty());
+    assert(files_in(dir) == 0 && "a drained queue keeps no files");
+  }
+
+  // --- variable-size values through a user codec, one record larger than a segment ---
+  {
+    spill_queue<std::string, string_codec> q(dir, 256);
+    q.push("a");
+    q.push(std::string(1000, 'x'));
+    q.push("");
+    q.push("tail");
+    assert(*q.pop() == "a");
+    assert(*q.pop() == std::string(1000, 'x'));
+    assert(*q.pop() == "");
+    assert(*q.pop() == "tail");
+    assert(!q.pop());
+  }
+
+  // --- bp_spill: lossless overflow for a stalled consumer ---
+  {
+    strand slow; // drained manually: the consumer is "down" until drain()
+    topic<std::string> audit;
+    auto p = std::make_shared<bp_spill<std::string, string_codec>>(dir, 8, 1024);
+    std::vector<std::string> got;
+    auto s = audit.subscribe(slow, priority{0}, p, [&](const std::string& v){ got.push_back(v); });
+
+    for (int i = 0; i < 500; ++i) audit.publish("event-" + std::to_string(i));
+    assert(p->spilled() == 492 && p->on_disk() == 492);
+    assert(files_in(dir) > 1);
+
+    slow.drain();
+    assert(got.size() == 500);
+    for (int i = 0; i < 500; ++i) assert(got[i] == "event-" + std::to_string(i));
+    assert(p->on_disk() == 0 && files_in(dir) == 0);
+
+    // Back to memory once the disk is drained
+    audit.publish("live");
+    assert(p->spilled() == 492);
+    slow.drain();
+    assert(got.back() == "live");
+    if constexpr (bp_stats::enabled) {
+      auto st = p->stats();
+      assert(st.accepted == 501 && st.dropped == 0 && st.high_water == 500 && st.depth == 0);
+    }
+  }
+
+  // --- bp_spill: a failing disk drops the event, other subscribers still get it ---
+  {
+    strand slow;
+    inline_executor ui;
+    topic<std::string> audit;
+    auto p = std::make_shared<bp_spill<std::string, string_codec>>(dir / "missing", 2, 1024);
+    std::vector<std::string> spilled_to_nowhere, others;
+    auto s1 = audit.subscribe(slow, priority{1}, p, [&](const std::string& v){ spilled_to_nowhere.push_back(v); });
+    auto s2 = audit.subscribe(ui, priority{0}, bp_none{},
+                              [&](const std::string& v){ others.push_back(v); });
+    for (int i = 0; i < 5; ++i) audit.publish("event-" + std::to_string(i));
+    assert(others.size() == 5 && "later subscribers are not skipped");
+    slow.drain();
+    assert((spilled_to_nowhere == std::vector<std::string>{"event-0", "event-1"}));
+    assert(p->spilled() == 0);
+    if constexpr (bp_stats::enabled) {
+      auto st = p->stats();
+      assert(st.accepted == 2 && st.dropped == 3);
+    }
+  }
+
+  fs::remove_all(dir);
+  std::cout << "[spill_tests] OK\n";
+  return 0;
+}
+#endif
@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <cassert>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <pulse/pulse.hpp>
+
+using namespace pulse;
+using namespace std::chrono_literals;
+
+static bool wait_for(const std::atomic<int>& counter, int expected) {
+  for (int i = 0; i < 500; ++i) {
+    if (counter.load(std::memory_order_acquire) >= expected) return true;
+    std::this_thread::sleep_for(1ms);
+  }
+  return false;
+}
+
+int main() {
+  // 1) cpulist parsing (sysfs format)
+  {
+    auto v = detail::parse_cpulist("0-3,8,10-11\n");
+    assert((v == std::vector<int>{0,1,2,3,8,10,11}) && "parse_cpulist: ranges and singles");
+    assert(detail::parse_cpulist("").empty());
+    assert((detail::parse_cpulist("5") == std::vector<int>{5}));
+  }
+
+  // 2) Topology: at least one node, every allowed CPU belongs to some node
+  auto topo = cpu_topology::detect();
+  assert(!topo.nodes.empty() && "detect: at least one node");
+  assert(topo.cpu_count() > 0);
+  const int first_cpu = topo.nodes.front().front();
+  assert(topo.node_of(first_cpu) == 0);
+  assert(topo.node_of(-1) == -1);
+
+  // 3) Pinned pool: every task runs on the requested CPU
+  {
+    thread_pool_options opts;
+    opts.threads = 2;
+    opts.cpus = { first_cpu };
+    thread_pool pool{opts};
+
+    std::atomic<int> done{0};
+    std::atomic<int> wrong_cpu{0};
+    for (int i = 0; i < 50; ++i) {
+      pool.post([&]{
+        const int cpu = current_cpu();
+        if (cpu >= 0 && cpu != first_cpu) wrong_cpu.fetch_add(1);
+        done.fetch_add(1, std::memory_order_release);
+      });
+    }
+    assert(wait_for(done, 50) && "pinned pool must run all tasks");
+#if defined(__linux__)
+    assert(wrong_cpu.load() == 0 && "pinned workers must stay on their CPU set");
+#endif
+  }
+
+  // 4) NUMA-aware pool: one queue per node, all work executed,
+  //    nested posts from workers stay on the pool
+  {
+    thread_pool_options opts;
+    opts.threads = 3;
+    opts.numa_aware = true;
+    opts.pin_per_cpu = true;
+    std::atomic<int> done{0};
+    {
+      thread_pool pool{opts};
+      assert(pool.queue_count() == std::min<std::size_t>(topo.nodes.size(), 3) && "numa_aware: one queue per node");
+
+      for (int i = 0; i < 100; ++i) {
+        pool.post([&]{
+          pool.post([&]{ done.fetch_add(1, std::memory_order_release); });
+        });
+      }
+      assert(wait_for(done, 100) && "numa_aware pool must run nested tasks");
+    }
+    assert(done.load() == 100);
+  }
+
+  // 5) Several queues (a made-up three-node layout): nodes without workers get
+  //    no queue, idle workers steal from a busy node and are not lost asleep
+  {
+    thread_pool_options opts;
+    opts.numa_aware = true;
+    opts.prefer_caller_node = false;
+    opts.topology.nodes = { {first_cpu}, {first_cpu}, {first_cpu} };
+
+    opts.threads = 1;
+    {
+      thread_pool pool{opts};
+      assert(pool.queue_count() == 1 && "no queue for nodes without workers");
+      std::atomic<int> done{0};
+      for (int i = 0; i < 30; ++i) pool.post([&]{ done.fetch_add(1, std::memory_order_release); });
+      assert(wait_for(done, 30));
+    }
+
+    opts.threads = 3;
+    thread_pool pool{opts};
+    assert(pool.queue_count() == 3);
+
+    // One worker is stuck; whatever lands on its queue is stolen by the others
+    std::atomic<bool> release{false};
+    std::atomic<int> blocked{0};
+    pool.post([&]{
+      blocked.store(1, std::memory_order_release);
+      while (!release.load(std::memory_order_acquire)) std::this_thread::sleep_for(1ms);
+    });
+    assert(wait_for(blocked, 1));
+    std::atomic<int> done{0};
+    for (int i = 0; i < 90; ++i) pool.post([&]{ done.fetch_add(1, std::memory_order_release); });
+    assert(wait_for(done, 90) && "tasks queued behind a busy worker are stolen");
+    release.store(true, std::memory_order_release);
+
+    // Post-and-wait round trips: every post must wake some worker
+    for (int i = 0; i < 500; ++i) {
+      std::atomic<int> one{0};
+      pool.post([&]{ one.store(1, std::memory_order_release); });
+      assert(wait_for(one, 1) && "no lost wake-up across queues");
+    }
+  }
+
+  // 6) Destruction drains the queue (as before)
+  {
+    std::atomic<int> done{0};
+    {
+      thread_pool pool{1};
+      for (int i = 0; i < 20; ++i)
+        pool.post([&]{ std::this_thread::sleep_for(1ms); done.fetch_add(1); });
+    }
+    assert(done.load() == 20 && "pending tasks are executed before the pool is destroyed");
+  }
+
+  std::cout << "[thread_pool_affinity_tests] OK\n";
+  return 0;
+}
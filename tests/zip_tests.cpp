@@ -0,0 +1,197 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <pulse/pulse.hpp>
+
+using namespace pulse;
+using namespace std::chrono_literals;
+
+static std::vector<int> iota(int a, int b) {
+  std::vector<int> v;
+  for (int x = a; x <= b; ++x) v.push_back(x);
+  return v;
+}
+
+// synchronous source that ignores demand
+static observable<int> burst(int n) {
+  return observable<int>::create([n](auto on_next, auto, auto on_done){
+    for (int i = 0; i < n; ++i) on_next(i);
+    on_done();
+    return subscription{};
+  });
+}
+
+int main() {
+  // 1) Variadic zip: one value from every source, mixed types
+  {
+    subject<int> a;
+    subject<std::string> b;
+    subject<double> c;
+    std::vector<std::string> got;
+    bool done = false;
+    auto sub = zip([](int x, const std::string& s, double d){ return s + std::to_string(x + static_cast<int>(d)); },
+                   a.as_observable(), b.as_observable(), c.as_observable())
+                 .subscribe([&](const std::string& v){ got.push_back(v); }, nullptr, [&]{ done = true; });
+    a.on_next(1);
+    a.on_next(2);
+    b.on_next("x");
+    assert(got.empty());
+    c.on_next(10.0);
+    assert((got == std::vector<std::string>{"x11"}));
+    b.on_next("y");
+    c.on_next(20.0);
+    assert((got == std::vector<std::string>{"x11", "y22"}));
+    a.on_completed();
+    assert(done && "a completed source with an empty buffer ends the zip");
+  }
+
+  // 2) The two-source form still works, demand-aware sources are pulled as far as needed
+  {
+    std::vector<int> got;
+    bool done = false;
+    auto sub = zip(from_range(iota(1, 3000)), from_range(iota(1, 2000)), [](int x, int y){ return x - y; })
+                 .subscribe([&](int v){ got.push_back(v); }, nullptr, [&]{ done = true; });
+    assert(got.size() == 2000 && done);
+    for (int v : got) assert(v == 0);
+  }
+
+  // 3) Overflow: block fails a source that ignores demand, drop keeps the first values, error fails
+  {
+    bool err = false;
+    std::vector<int> got;
+    auto sub = zip(zip_options{.capacity = 8}, [](int x, int y){ return x + y; },
+                   burst(100), from_range(iota(0, 99)))
+                 .subscribe([&](int v){ got.push_back(v); }, [&](std::exception_ptr){ err = true; });
+    assert(err && got.empty() && "block: a source that ignores demand overflows");
+  }
+  {
+    std::vector<int> got;
+    bool done = false;
+    auto sub = zip(zip_options{.capacity = 8, .overflow = zip_overflow::drop}, [](int x, int y){ return x * 1000 + y; },
+                   burst(100), from_range(iota(0, 99)))
+                 .subscribe([&](int v){ got.push_back(v); }, nullptr, [&]{ done = true; });
+    assert(got.size() == 8 && done && "drop: the ring keeps the first 8 values");
+    for (int i = 0; i < 8; ++i) assert(got[i] == i * 1000 + i);
+  }
+  {
+    subject<int> a, b;
+    std::string what;
+    auto sub = zip(zip_options{.capacity = 4, .overflow = zip_overflow::error}, [](int x, int y){ return x + y; },
+                   a.as_observable(), b.as_observable())
+                 .subscribe([](int){}, [&](std::exception_ptr e){
+                   try { std::rethrow_exception(e); } catch (const std::overflow_error& ex) { what = ex.what(); }
+                 });
+    for (int i = 0; i < 4; ++i) a.on_next(i);
+    assert(what.empty());
+    a.on_next(4);
+    assert(!what.empty());
+  }
+
+  // 4) Block: a fast demand-aware source is held at the ring capacity
+  {
+    int pulled = 0;
+    subject<int> slow;
+    auto fast = from_range(iota(0, 10000)) | map([&](int v){ ++pulled; return v; });
+    int count = 0;
+    auto sub = zip(zip_options{.capacity = 16}, [](int x, int y){ return x + y; }, fast, slow.as_observable())
+                 .subscribe([&](int){ ++count; });
+    assert(pulled == 16 && "no more than the ring holds");
+    for (int i = 0; i < 10; ++i) slow.on_next(i);
+    assert(count == 10 && pulled > 16 && pulled <= 26 && "refilled up to the capacity again");
+  }
+
+  // 5) Downstream demand bounds every source (8-way)
+  {
+    auto d = std::make_shared<demand>();
+    std::vector<int> got;
+    auto s = from_range(iota(1, 100));
+    auto sub = zip([](int a, int b, int c, int e, int f, int g, int h, int i){ return a + b + c + e + f + g + h + i; },
+                   s, s, s, s, s, s, s, s)
+                 .subscribe([&](int v){ got.push_back(v); }, nullptr, nullptr, d);
+    assert(got.empty());
+    d->request(2);
+    assert((got == std::vector<int>{8, 16}));
+  }
+
+  // 6) Errors: f throwing or a source failing ends the zip
+  {
+    subject<int> a, b;
+    bool err = false;
+    int count = 0;
+    auto sub = zip([](int x, int y){ if (x == 2) throw std::runtime_error("f"); return x + y; },
+                   a.as_observable(), b.as_observable())
+                 .subscribe([&](int){ ++count; }, [&](std::exception_ptr){ err = true; });
+    a.on_next(1); b.on_next(1);
+    a.on_next(2); b.on_next(2);
+    assert(err && count == 1);
+    a.on_next(3); b.on_next(3);
+    assert(count == 1);
+  }
+
+  // 7) Sources on their own threads: every tuple exactly once, in order
+  {
+    constexpr int n = 20000;
+    subject<int> a, b, c;
+    std::atomic<long long> sum{0};
+    std::atomic<int> count{0};
+    bool in_order = true;
+    int last = -1;
+    auto sub = zip([](int x, int y, int z){ return std::make_tuple(x, y, z); },
+                   a.as_observable(), b.as_observable(), c.as_observable())
+                 .subscribe([&](std::tuple<int, int, int> t){
+                   auto [x, y, z] = t;
+                   in_order = in_order && x == y && y == z && x == last + 1;
+                   last = x;
+                   sum += x;
+                   ++count;
+                 });
+    std::thread ta([&]{ for (int i = 0; i < n; ++i) a.on_next(i); });
+    std::thread tb([&]{ for (int i = 0; i < n; ++i) b.on_next(i); });
+    std::thread tc([&]{ for (int i = 0; i < n; ++i) c.on_next(i); });
+    ta.join(); tb.join(); tc.join();
+    assert(count == n && in_order);
+    assert(sum == static_cast<long long>(n) * (n - 1) / 2);
+  }
+
+  // 8) Without options buffers grow: sources that ignore demand are never cut off
+  {
+    int count = 0;
+    bool err = false, done = false;
+    auto sub = zip(burst(2000), burst(2000), [](int x, int y){ return x - y; })
+                 .subscribe([&](int v){ assert(v == 0); ++count; },
+                            [&](std::exception_ptr){ err = true; }, [&]{ done = true; });
+    assert(count == 2000 && !err && done);
+  }
+
+  // 9) One source fed from several threads at once (a subject shared by emitters)
+  {
+    constexpr int per_thread = 20000, threads = 4;
+    subject<int> a, b;
+    std::atomic<int> count{0};
+    std::atomic<long long> sum{0};
+    std::atomic<bool> go{false};
+    auto sub = zip([](int x, int y){ return x + y; }, a.as_observable(), b.as_observable())
+                 .subscribe([&](int v){ sum += v; ++count; });
+    for (int i = 0; i < per_thread * threads; ++i) b.on_next(1);
+    std::vector<std::thread> emitters;
+    for (int t = 0; t < threads; ++t)
+      emitters.emplace_back([&]{
+        while (!go.load()) std::this_thread::yield();
+        for (int i = 0; i < per_thread; ++i) a.on_next(1);
+      });
+    go.store(true);
+    for (auto& t : emitters) t.join();
+    assert(count == per_thread * threads && sum == 2LL * per_thread * threads);
+  }
+
+  std::cout << "[zip_tests] OK\n";
+  return 0;
+}